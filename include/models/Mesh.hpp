@@ -1,15 +1,24 @@
 #pragma once
 #include <GL/glew.h>
 #include <glm/glm.hpp>
-#include <vector>
+#include <cstddef>
+#include "include/utils/GlObject.hpp"
 
 struct Mesh {
-    std::vector<glm::vec3> vertices;    // 3D vertex positions
-    std::vector<glm::vec3> normals;     // Vertex normals for lighting
-    std::vector<glm::vec2> texCoords;   // Texture coordinates
-    std::vector<unsigned int> indices;   // Vertex indices for drawing
-    GLuint VAO;                         // Vertex Array Object
-    GLuint texture;                     // Diffuse texture
+    // Interleaved vertex, the layout stored in the mesh cache and uploaded as is
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;   // Vertex normal for lighting
+        glm::vec2 texCoord;
+    };
 
-    void setupMesh();
+    GlVertexArray VAO;          // Vertex Array Object
+    GlBuffer vertexBuffer;      // Interleaved vertices
+    GlBuffer indexBuffer;
+    GLuint texture = 0;         // Diffuse texture, owned by TextureCache
+    unsigned int indexCount = 0; // Indices drawn as triangles
+
+    // Uploads the vertices and indices (e.g. straight from a mapped mesh cache) into one buffer each.
+    // Nothing is kept on the CPU, the buffers are freed with the mesh.
+    void upload(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount);
 };
@@ -0,0 +1,68 @@
+#pragma once
+#include "Mesh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// GPU-ready binary form of an imported model:
+// - compile() runs the Assimp import once and flattens every mesh into interleaved vertices, indices and a
+//   material table
+// - load() memory-maps the result, so later launches upload straight from the mapping without touching Assimp
+// - The cache stores a hash of the model and the buffers it references, and is rebuilt when they change
+// File layout: FileHeader, MeshRecord[meshCount], MaterialRecord[materialCount], Mesh::Vertex[vertexCount],
+// uint32 indices[indexCount], string table
+class MeshCache {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct FileHeader {
+        char magic[4];        // "SMSH"
+        uint32_t version;
+        uint64_t sourceHash;  // sourceHash() of the model it was compiled from
+        uint32_t meshCount;
+        uint32_t materialCount;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t stringBytes;
+        uint32_t reserved;
+    };
+
+    struct MeshRecord {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstIndex;  // Indices are relative to the mesh's first vertex
+        uint32_t indexCount;
+        uint32_t material;
+    };
+
+    // Strings are byte offsets into the string table; offset 0 is the empty string
+    struct MaterialRecord {
+        uint32_t diffuseTexture; // Path as written in the model, relative to its directory
+    };
+
+    const unsigned char* data = nullptr; // Mapped file
+    size_t size = 0;
+
+    // Maps the cache for modelPath, compiling it first when it is missing, damaged or from another source
+    static MeshCache load(const std::string& modelPath, const std::string& cachePath);
+
+    // Imports the model with Assimp and writes the cache
+    static bool compile(const std::string& modelPath, const std::string& cachePath, uint64_t sourceHash);
+
+    // Hash of the model file plus the buffer files a glTF references (not its images), 0 when it cannot be read
+    static uint64_t sourceHash(const std::string& modelPath);
+
+    // Cache path used for a model by default: cache/<model directory>_<model name>.smsh
+    static std::string cachePath(const std::string& modelPath);
+
+    bool valid() const { return data != nullptr; }
+
+    const FileHeader& header() const { return *reinterpret_cast<const FileHeader*>(data); }
+    const MeshRecord& mesh(uint32_t index) const;
+    const MaterialRecord& material(uint32_t index) const;
+    const Mesh::Vertex* vertices() const;
+    const uint32_t* indices() const;
+    const char* string(uint32_t offset) const;
+
+    void close();
+};
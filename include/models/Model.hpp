@@ -1,6 +1,5 @@
 #pragma once
 #include <GL/glew.h>
-#include <assimp/scene.h>
 #include <vector>
 #include "Mesh.hpp"
 
@@ -8,8 +7,7 @@ struct Model {
     std::vector<Mesh> meshes;
 
     void Draw(GLuint shader);
-    static Model loadFromFile(const char* path);
 
-private:
-    static void processNode(Model& model, aiNode* node, const aiScene* scene);
+    // Uploads the model from its mesh cache (see MeshCache.hpp), converting it with Assimp on first use
+    static Model loadFromFile(const char* path);
 };
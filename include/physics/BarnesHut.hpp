@@ -0,0 +1,55 @@
+#pragma once
+#include "include/physics/NBodySystem.hpp"
+#include <cstdint>
+#include <vector>
+
+// O(N log N) gravity through a Barnes-Hut octree:
+// - Particles are sorted along a Morton curve, so every octree cell is a contiguous range
+// - The tree is rebuilt every step; the top levels are split serially and the subtrees below are built in parallel
+// - Cells that look small from a particle (size / distance < theta) act as a single point mass
+// - Kick-drift-kick leapfrog integration, time reversible and symplectic
+class BarnesHut {
+public:
+    static constexpr int LEAF_CAPACITY = 8;   // Particles summed directly in a leaf
+    static constexpr int MAX_DEPTH = 21;      // Morton code bits per axis
+    static constexpr int PARALLEL_DEPTH = 2;  // Subtrees below this level are built concurrently (up to 64)
+
+    struct Node {
+        double comX, comY, comZ;  // Center of mass
+        double mass;
+        double size;              // Cell edge length
+        uint32_t begin, end;      // Range in the Morton-sorted particle order
+        int32_t firstChild;       // Children are stored contiguously, -1 for a leaf
+        int32_t childCount;
+    };
+
+    struct Stats {
+        double buildSeconds;  // Sort and tree construction
+        double forceSeconds;  // Tree walk for every particle
+        size_t nodeCount;
+    };
+
+    double theta;  // Opening angle: 0 = exact, larger trades accuracy for speed
+
+    std::vector<Node> nodes;      // Root at index 0
+    std::vector<uint32_t> order;  // Sorted position -> particle index
+    std::vector<uint64_t> codes;  // Sorted Morton codes
+    std::vector<double> sortedX, sortedY, sortedZ, sortedMass;
+    Stats lastStats;
+
+    explicit BarnesHut(double theta = 0.5);
+
+    // Rebuilds the octree for the current positions
+    void build(const NBodySystem& system);
+
+    // Rebuilds the tree and fills the system's accelerations
+    void computeAccelerations(NBodySystem& system);
+
+    // Advances the system by dt with one leapfrog step (dt may be negative)
+    void step(NBodySystem& system, double dt);
+
+private:
+    void buildNode(std::vector<Node>& out, int32_t slot, uint32_t begin, uint32_t end, int level, double size,
+                   std::vector<int32_t>* deferred);
+    void accumulateLeaf(Node& node) const;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "include/physics/NBodySystem.hpp"
+#include <cstddef>
+
+// Exact O(N^2) gravity for small systems (tens to a few thousand bodies), where a tree costs more than it saves:
+// - Vectorized over target particles with AVX-512 or AVX2+FMA when the compiler enables them, scalar otherwise
+// - Blocks of targets sweep the sources in L1-sized tiles, blocks are spread over threads
+// - Yoshida 4th-order symplectic integration, so energy error stays bounded over long time-lapses
+class DirectSummation {
+public:
+    static constexpr size_t TILE = 256;  // Source particles per tile (4 arrays x 256 doubles = 8 KB)
+    static constexpr size_t BLOCK = 64;  // Target particles per block, one block per task
+
+    struct Stats {
+        double forceSeconds;          // Last force evaluation
+        double interactionsPerSecond; // Pairwise interactions evaluated per second in the last evaluation
+    };
+
+    Stats lastStats = {0.0, 0.0};
+
+    // Name of the kernel compiled in ("avx512", "avx2" or "scalar")
+    static const char* kernelName();
+
+    // Fills the system's accelerations by summing every pair
+    void computeAccelerations(NBodySystem& system);
+
+    // Advances the system by dt with one Yoshida 4th-order step, three force evaluations (dt may be negative)
+    void step(NBodySystem& system, double dt);
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "include/physics/KeplerianElements.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Chebyshev-polynomial ephemeris cache for real planetary positions:
+// - The analytic source (KeplerianElements) is sampled once and fitted into fixed-length segments per body,
+//   short segments for fast movers (Moon, Mercury), long ones for the outer planets
+// - Segments live in a binary file that is memory-mapped, so startup costs nothing once the file exists
+// - Evaluating a position at any Julian date is a segment lookup plus one Clenshaw recurrence per axis
+// File layout: FileHeader, one BodyRecord per body, then per segment [3][COEFFICIENTS] doubles (x, y, z)
+class Ephemeris {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int COEFFICIENTS = 13; // Chebyshev degree 12 per axis and segment
+
+    struct FileHeader {
+        char magic[4];          // "SEPH"
+        uint32_t version;
+        uint32_t bodyCount;
+        uint32_t coefficientCount;
+        double startJulianDate;
+        double endJulianDate;
+    };
+
+    struct BodyRecord {
+        double segmentDays;
+        uint64_t offset;        // Byte offset of the first segment from the start of the file
+        uint32_t segmentCount;
+        uint32_t reserved;
+    };
+
+    const unsigned char* data = nullptr; // Mapped file
+    size_t size = 0;
+    double startJulianDate = 0.0;
+    double endJulianDate = 0.0;
+
+    // Maps the cache at path, (re)building it first when it is missing or covers a different date range
+    static Ephemeris load(const std::string& path, double startJulianDate, double endJulianDate);
+
+    // Fits every body over [startJulianDate, endJulianDate] and writes the cache file
+    static bool build(const std::string& path, double startJulianDate, double endJulianDate);
+
+    bool valid() const { return data != nullptr; }
+
+    // Heliocentric ecliptic J2000 position in AU (geocentric for the Moon), dates outside the cache are clamped
+    glm::dvec3 position(KeplerianElements::Body body, double julianDate) const;
+
+    void close();
+
+    // Calendar conversions (Gregorian, 0h UT)
+    static double julianDate(int year, int month, int day);
+    static bool parseDate(const std::string& text, double& julianDate); // YYYY-MM-DD
+    static std::string calendarDate(double julianDate);
+    static double currentJulianDate();
+};
+
+// Maps heliocentric distances in AU onto the compressed scene orbit radii:
+// - Piecewise linear through (semi-major axis, scene orbit radius) knots, so every planet stays near its scene orbit
+// - Direction is kept, ecliptic (x, y, z) becomes world (x, z, -y) like the star catalog, north pole up
+struct OrbitScale {
+    std::vector<std::pair<double, double>> knots; // (AU, scene units), sorted by AU
+
+    void addKnot(double au, double sceneRadius);
+    double sceneDistance(double au) const;
+    glm::dvec3 toScene(const glm::dvec3& heliocentricAU) const;
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Low-precision analytic positions, used once to fit the Chebyshev ephemeris cache:
+// - Planets from JPL's "Approximate Positions of the Planets" mean elements and rates (Standish, 1800-2050 fit,
+//   arcminute-level inside that window and degrading slowly outside it)
+// - Moon from a mean-element model with regressing node and advancing perigee
+namespace KeplerianElements {
+enum Body { Mercury, Venus, Earth, Mars, Jupiter, Saturn, Uranus, Neptune, Moon, BODY_COUNT };
+
+constexpr double J2000 = 2451545.0; // Julian date of 2000 January 1.5 TT
+
+// Heliocentric ecliptic J2000 position in AU (geocentric for the Moon)
+glm::dvec3 position(Body body, double julianDate);
+
+// Mean semi-major axis in AU (the Moon's is geocentric)
+double semiMajorAxis(Body body);
+}
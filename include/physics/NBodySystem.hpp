@@ -0,0 +1,34 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+// Particle state for the gravity solvers, stored as structure-of-arrays doubles:
+// - Positions, velocities and accelerations in separate arrays so force loops stream through memory
+// - Double precision so long integrations do not drift from rounding alone
+struct NBodySystem {
+    std::vector<double> x, y, z;
+    std::vector<double> vx, vy, vz;
+    std::vector<double> ax, ay, az;
+    std::vector<double> mass;
+
+    double gravitationalConstant = 1.0;
+    double softening = 0.0;           // Plummer softening length, keeps close encounters finite
+    bool accelerationsValid = false;  // Cleared whenever positions change outside a solver
+
+    size_t size() const { return x.size(); }
+
+    // Appends a particle and returns its index
+    size_t add(const glm::dvec3& position, const glm::dvec3& velocity, double particleMass);
+
+    glm::dvec3 position(size_t i) const;
+    glm::dvec3 velocity(size_t i) const;
+
+    void clear();
+
+    // Moves the frame so the total momentum is zero (the system stays in place instead of drifting)
+    void removeMomentum();
+
+    // Kinetic plus softened potential energy, O(N^2) so only meant for diagnostics on small systems
+    double totalEnergy() const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+// Runs run(context, chunk) for every chunk in [0, chunkCount) on a pool of worker threads started on first use and
+// kept for the rest of the process. The calling thread works on its own chunks too, so calls may nest (a body can
+// call parallelFor) and may come from several threads at once. Returns when every chunk has finished.
+void runParallel(size_t chunkCount, void (*run)(void* context, size_t chunk), void* context);
+
+// Splits [0, count) into one contiguous chunk per hardware thread and runs body(begin, end) on each.
+// Runs inline when the work is too small to be worth a thread (minChunk items per thread).
+template <typename Body>
+void parallelFor(size_t count, Body body, size_t minChunk = 256) {
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<size_t>(1, count / std::max<size_t>(1, minChunk)));
+    if (threadCount <= 1) {
+        body(size_t(0), count);
+        return;
+    }
+
+    struct Context {
+        Body& body;
+        size_t chunk;
+        size_t count;
+    };
+    Context context = {body, (count + threadCount - 1) / threadCount, count};
+    size_t chunkCount = (count + context.chunk - 1) / context.chunk;
+    runParallel(chunkCount, [](void* pointer, size_t chunk) {
+        Context& context = *static_cast<Context*>(pointer);
+        size_t begin = chunk * context.chunk;
+        context.body(begin, std::min(begin + context.chunk, context.count));
+    }, &context);
+}
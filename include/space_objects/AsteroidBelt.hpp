@@ -0,0 +1,62 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "include/utils/GlObject.hpp"
+
+// Small-body population evaluated entirely on the GPU:
+// - Each asteroid is 32 bytes of static orbital elements in an instance buffer, written once at startup
+// - The vertex shader solves Kepler's equation from the simulation clock, so there are no per-frame CPU updates
+// - One instanced draw covers the whole belt, each instance picks one of a few procedural rock shapes
+// - Real catalogs (SmallBodyCatalog) keep their elements in AU and stream in with reserve()/append();
+//   distanceKnots then maps AU onto the compressed scene distances like OrbitScale
+class AsteroidBelt {
+public:
+    static constexpr int ROCK_VARIANTS = 4;   // Distinct rock shapes, must match the vertex shader
+    static constexpr int ROCK_VERTICES = 12;  // Displaced icosahedron corners per shape
+    static constexpr int ROCK_DRAW_VERTICES = 60; // 20 triangles, expanded in the shader for flat normals
+    static constexpr int MAX_DISTANCE_KNOTS = 16; // Must match the vertex shader
+
+    struct Asteroid {
+        float semiMajorAxis;        // Scene units (AU with distanceKnots)
+        float eccentricity;
+        float inclination;          // Radians
+        float ascendingNode;        // Radians
+        float argumentOfPeriapsis;  // Radians
+        float meanAnomaly;          // Radians, at orbit angle 0
+        float size;                 // Rock radius, scene units
+        float spinPhase;            // Radians, also seeds the rock's tint
+    };
+
+    GlVertexArray vao;     // Instance attributes only, rock corners come from a uniform array
+    GlBuffer instanceVbo;  // Packed Asteroid records
+    unsigned int count;    // Number of asteroids
+    unsigned int capacity; // Instances the buffer has room for
+    float referenceRadius; // Orbit radius that advances one radian per radian of orbit angle (Earth's)
+    std::vector<glm::vec2> distanceKnots; // (AU, scene units) for elements in AU, empty when already in scene units
+    glm::vec3 rockVertices[ROCK_VARIANTS * ROCK_VERTICES];
+
+    // Factory method, scatters asteroids between the two radii with a fixed seed so every run looks the same
+    static AsteroidBelt create(unsigned int count,
+                               float innerRadius,
+                               float outerRadius,
+                               float referenceRadius,
+                               unsigned int seed);
+
+    // Empties the belt and allocates room for capacity instances, filled later with append()
+    void reserve(unsigned int capacity);
+
+    // Uploads more instances after the current ones, up to the reserved capacity
+    void append(const Asteroid* asteroids, unsigned int appendCount);
+
+    // Draws every asteroid in one instanced call
+    // orbitAngle: simulation clock as Earth's orbital angle in radians
+    // collapse: 0 = normal orbits, 1 = fully swallowed by the black hole at collapseCenter
+    void render(GLuint shader,
+                const glm::mat4& viewMatrix,
+                const glm::mat4& projectionMatrix,
+                const glm::vec3& sunPosition,
+                float orbitAngle,
+                float collapse,
+                const glm::vec3& collapseCenter) const;
+};
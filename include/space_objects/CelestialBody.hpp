@@ -5,15 +5,18 @@
 #include <vector>
 
 struct CelestialBody {
-    GLuint vao;              // Vertex Array Object for the sphere
-    GLuint texture;          // Body's surface texture
+    GLuint vao;              // Shared sphere Vertex Array Object (owned by SphereUtils)
+    GLuint texture;          // Body's surface texture (owned by TextureCache)
+    glm::vec3 averageColor;  // Mean surface color, used when the body is drawn as a point
     unsigned int indexCount; // Number of indices for rendering
-    glm::vec3 position;      // Current position in space
+    glm::dvec3 position;     // Current position in world space (double, see FloatingOrigin)
     glm::vec3 scale;         // Size of the celestial body
     float rotationAngle;     // Current rotation around its axis
     float rotationSpeed;     // Speed of rotation around its axis
     float orbitRadius;       // Distance from the center of orbit
     float orbitSpeed;        // Speed of orbital movement
+    int transformNode;       // Node in the scene's TransformHierarchy (-1 = none)
+    bool atmosphere;         // Rim glow from an atmosphere, off for bodies marked 'airless' in the scene
 
     // Factory method to create a celestial body
     static CelestialBody create(const char* texturePath,
@@ -23,19 +26,29 @@ struct CelestialBody {
                                float rotationSpeed);
 
     // Update the celestial body's position and rotation
-    void update(const glm::vec3& centerPosition, float baseAngle, float dt);
-    
-    // Get the world transformation matrix for rendering
-    glm::mat4 getWorldMatrix() const;
+    // baseAngle is the simulation clock in degrees of Earth's orbit, double so long time-lapses keep their precision
+    void update(const glm::dvec3& centerPosition, double baseAngle, float dt);
+
+    // Scripted orbit position relative to the orbit center
+    glm::dvec3 orbitOffset(double baseAngle) const;
 
-    // Render the celestial body
+    // Rotate around the body's axis, wrapped to [0, 360) so fast time-lapses do not lose precision
+    void spin(float dt);
+    
+    // Render the celestial body with a ShaderPrograms::bodies variant (sun, shadows and atmosphere are compiled in)
+    // worldMatrix comes from TransformHierarchy::renderMatrix; it and lightPos/viewPos are in render space
     void render(GLuint shader,
 		const glm::mat4 &viewMatrix,
 		const glm::mat4 &projectionMatrix,
+		const glm::mat4 &worldMatrix,
 		const glm::vec3 &lightPos,
-		const glm::vec3 &viewPos,
-		bool isSun = false,
-const std::vector<glm::vec3> &allPlanetPositions = std::vector<glm::vec3>(),
-    	const std::vector<float> &allPlanetRadii = std::vector<float>()
-	) const;
+		const glm::vec3 &viewPos) const;
+
+    // Render as a ray-traced impostor: one camera-facing quad, exact silhouette and depth at any zoom
+    void renderImpostor(GLuint shader,
+                        const glm::mat4 &viewMatrix,
+                        const glm::mat4 &projectionMatrix,
+                        const glm::mat4 &worldMatrix,
+                        const glm::vec3 &lightPos,
+                        const glm::vec3 &viewPos) const;
 };
@@ -3,34 +3,48 @@
 #include <GL/glew.h>
 #include "CelestialBody.hpp"
 #include "TrailPoint.hpp"
+#include "include/utils/GlObject.hpp"
+#include "include/world/FloatingOrigin.hpp"
 
 class Comet {
 public:
     CelestialBody body;            // Reuse existing celestial body for the head
     std::vector<TrailPoint> trail; // Trail points
-    float orbitAngle;              // Current angle in elliptical orbit
+    double orbitAngle;             // Current angle in elliptical orbit (true anomaly, radians)
+    double meanMotion;             // Average angular rate in radians per second, sets the period
     float eccentricity;            // How elliptical the orbit is (0 = circle, 0.9 = very elliptical)
     float semiMajorAxis;           // Size of the orbit
-    glm::vec3 orbitCenter;         // Center point of orbit
-    GLuint trailVAO;               // VAO for trail rendering
-    GLuint trailVBO;               // VBO for trail vertices
+    glm::dvec3 orbitCenter;        // Center point of orbit
+    GlVertexArray trailVAO;        // VAO for trail rendering
+    GlBuffer trailVBO;             // VBO for trail vertices
+    glm::dvec3 trailAnchor;        // World position the trail vertices are stored relative to (newest point)
     int maxTrailPoints;            // Maximum trail length
     float lastTrailUpdate;         // Time tracking for trail updates
 
     // Factory method to create a comet
     static Comet create(const char* texturePath,
-                       const glm::vec3& orbitCenter,
+                       const glm::dvec3& orbitCenter,
                        float semiMajorAxis,
                        float eccentricity);
 
-    // Update comet's position and trail
-    void update(float dt, const glm::vec3& sunPosition);
+    // Angular rate at the given angle from Kepler's second law: fast near the sun, slow far out
+    double angularRate(double angle) const;
 
-    void updateTrail(float currentTime, const glm::vec3& sunPosition);
+    // Largest substep that keeps the angle change small at the current position
+    double preferredStep() const;
+
+    // Integrates the orbit angle by dt (RK4), called once per simulation substep
+    void advance(double dt);
+
+    // Place the head for the current angle, spin it and extend the trail (once per frame)
+    void update(float dt, const glm::dvec3& sunPosition);
+
+    void updateTrail(float currentTime, const glm::dvec3& sunPosition);
     void updateTrailVBO();
 
     // Render the comet's trail
     void renderTrail(GLuint shader, 
                     const glm::mat4& viewMatrix, 
-                    const glm::mat4& projectionMatrix) const;
+                    const glm::mat4& projectionMatrix,
+                    const FloatingOrigin& origin) const;
 };
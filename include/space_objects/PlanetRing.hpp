@@ -2,22 +2,23 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include "CelestialBody.hpp"
+#include "include/utils/SphereUtils.hpp"
 
 struct PlanetRing {
-    GLuint vao;
-    GLuint texture;
+    SphereUtils::Buffers geometry; // Flat annulus
+    GLuint texture;                // Owned by TextureCache
     unsigned int indexCount;
     float innerRadius;
     float outerRadius;
 
-    // Factory method to create Saturn's rings
-    static PlanetRing createSaturnRings();
+    // Factory method to create a flat ring between the two radii (in units of the planet's radius)
+    static PlanetRing create(const char* texturePath, float innerRadius, float outerRadius);
 
-    // Render the planet ring
-    void render(const CelestialBody& planet,
-                GLuint shader,
+    // Render the planet ring; worldMatrix is the ring's node in the TransformHierarchy (render space)
+    void render(GLuint shader,
                 const glm::mat4& viewMatrix,
                 const glm::mat4& projectionMatrix,
+                const glm::mat4& worldMatrix,
                 const glm::vec3& lightPos,
                 const glm::vec3& viewPos) const;
 };
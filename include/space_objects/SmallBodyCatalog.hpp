@@ -0,0 +1,55 @@
+#pragma once
+#include "include/space_objects/AsteroidBelt.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+
+// Real asteroid and comet population from an orbital-element catalog (e.g. a JPL Small-Body Database CSV export):
+// - First launch parses the text on a background thread, split across all cores, with SIMD delimiter scanning,
+//   into a binary cache of packed AsteroidBelt::Asteroid records (elements in AU and radians)
+// - Later launches memory-map the cache, which is rebuilt when the source file changes
+// - stream() feeds the mapped records into the belt's instance buffer a chunk per frame, so the app stays
+//   interactive while a million bodies arrive
+// CSV needs a header row with a, e, i, om, w, ma columns (angles in degrees); q replaces a for comets given by
+// perihelion distance, and epoch (JD), H and diameter (km) are used when present. Unbound orbits are skipped.
+// Cache layout: FileHeader, then count Asteroid records
+class SmallBodyCatalog {
+public:
+    static constexpr uint32_t VERSION = 1;
+    using Asteroid = AsteroidBelt::Asteroid;
+
+    struct FileHeader {
+        char magic[4];      // "SSBC"
+        uint32_t version;
+        int64_t sourceTime; // Modification time and size of the catalog it was built from
+        uint64_t sourceSize;
+        uint64_t count;     // Records that follow
+        uint64_t skipped;   // Rows without usable elements
+    };
+
+    std::string sourcePath;
+    std::string cachePath;
+    std::future<bool> ingest;           // Background parse when the cache had to be (re)built
+    const unsigned char* data = nullptr; // Mapped cache
+    size_t size = 0;
+    uint64_t streamed = 0;              // Records uploaded so far
+
+    // Maps the cache for sourcePath, or starts building it in the background; returns immediately
+    static SmallBodyCatalog open(const std::string& sourcePath, const std::string& cachePath);
+
+    // Parses the catalog and writes the cache (blocking, uses every core)
+    static bool build(const std::string& sourcePath, const std::string& cachePath);
+
+    // Cache path used for a catalog by default: cache/<catalog name>.ssbc
+    static std::string defaultCachePath(const std::string& sourcePath);
+
+    // Uploads up to maxRecords more records into the belt, reserving room on the first call (GL thread, once per frame)
+    void stream(AsteroidBelt& belt, unsigned int maxRecords);
+
+    bool loading() const { return ingest.valid(); }
+    bool complete() const { return data != nullptr && streamed == count(); }
+    uint64_t count() const;
+
+    void close();
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Single-file archive of the runtime assets (shaders/, textures/, models/):
+// - tools/make_asset_pack.cpp bundles the directories into one indexed file, every asset 64-byte aligned
+// - mount() maps the pack once at startup, find() returns a view straight into the mapping: no copy and no
+//   open() per asset, which is what dominates cold starts from network-mounted images
+// - Loaders ask the pack first and fall back to loose files for anything it does not hold, so working without
+//   a pack is unchanged. The pack wins over loose files, rebuild it after editing assets.
+// File layout: FileHeader, Entry[entryCount] sorted by name, name table, asset data
+class AssetPack {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t ALIGNMENT = 64;
+
+    struct FileHeader {
+        char magic[4];       // "SPAK"
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t nameBytes;
+    };
+
+    struct Entry {
+        uint32_t name;       // Byte offset into the name table
+        uint32_t nameLength;
+        uint64_t offset;     // From the start of the file, ALIGNMENT aligned
+        uint64_t size;
+    };
+
+    // Maps the pack, replacing any mounted one; false (and loose files only) when it is missing or damaged
+    static bool mount(const std::string& packPath);
+    static void unmount();
+    static bool mounted();
+
+    // Contents of the asset at path (relative to the repository root), false when the pack does not hold it
+    static bool find(const std::string& path, std::string_view& contents);
+
+    // Contents from the pack, or else from the loose file; false when neither exists
+    static bool read(const std::string& path, std::string& contents);
+
+    // Writes a pack holding the given files, stored under their paths as given
+    static bool write(const std::string& packPath, std::vector<std::string> paths);
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+
+// GLSL sources compiled into the executable, so it runs from any working directory.
+// src/utils/EmbeddedShaders.cpp is generated from shaders/ by tools/embed_shaders.cpp; rerun it after editing a shader.
+namespace EmbeddedShaders {
+
+struct Source {
+    const char* path; // As the renderer asks for it: "shaders/ui.vert.glsl"
+    const char* text;
+};
+
+// Sorted by path
+extern const Source SOURCES[];
+extern const size_t SOURCE_COUNT;
+
+}
@@ -1,8 +1,14 @@
 #pragma once
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "include/utils/GlObject.hpp"
 
 namespace GeometryUtils {
-    // Creates a basic colored cube vertex buffer object
-    GLuint createVertexBufferObject();
+    struct VertexBuffers {
+        GlVertexArray vao;
+        GlBuffer vbo;
+    };
+
+    // Creates a basic colored cube: 36 vertices with position (attribute 0) and color (attribute 1)
+    VertexBuffers createVertexBufferObject();
 }
@@ -0,0 +1,71 @@
+#pragma once
+#include <GL/glew.h>
+#include <utility>
+
+enum class GlKind { Buffer, Texture, VertexArray, Renderbuffer, Framebuffer, Query };
+
+// Deletes the object and drops it from MemoryBudget. Once the GL context is gone only the bookkeeping is dropped.
+void deleteGlObject(GlKind kind, GLuint name);
+
+// Call right before destroying the GL context, objects released afterwards (e.g. by destructors running after
+// glfwTerminate) must not reach the driver
+void markGlContextDestroyed();
+
+// Owning GL object name, deleted when the owner goes away:
+// - Move-only, so a buffer or texture has exactly one owner
+// - Converts to GLuint, so it passes straight to gl* calls and RenderState
+template <GlKind Kind>
+class GlObject {
+public:
+    GlObject() = default;
+    explicit GlObject(GLuint name) : name(name) {}
+    GlObject(GlObject&& other) noexcept : name(std::exchange(other.name, 0)) {}
+    GlObject& operator=(GlObject&& other) noexcept {
+        if (this != &other) {
+            reset();
+            name = std::exchange(other.name, 0);
+        }
+        return *this;
+    }
+    GlObject(const GlObject&) = delete;
+    GlObject& operator=(const GlObject&) = delete;
+    ~GlObject() { reset(); }
+
+    // Generates a new object of this kind
+    static GlObject create() {
+        GLuint created = 0;
+        if constexpr (Kind == GlKind::Buffer) {
+            glGenBuffers(1, &created);
+        } else if constexpr (Kind == GlKind::Texture) {
+            glGenTextures(1, &created);
+        } else if constexpr (Kind == GlKind::VertexArray) {
+            glGenVertexArrays(1, &created);
+        } else if constexpr (Kind == GlKind::Renderbuffer) {
+            glGenRenderbuffers(1, &created);
+        } else if constexpr (Kind == GlKind::Framebuffer) {
+            glGenFramebuffers(1, &created);
+        } else {
+            glGenQueries(1, &created);
+        }
+        return GlObject(created);
+    }
+
+    operator GLuint() const { return name; }
+
+    void reset() {
+        if (name != 0) {
+            deleteGlObject(Kind, name);
+            name = 0;
+        }
+    }
+
+private:
+    GLuint name = 0;
+};
+
+using GlBuffer = GlObject<GlKind::Buffer>;
+using GlTexture = GlObject<GlKind::Texture>;
+using GlVertexArray = GlObject<GlKind::VertexArray>;
+using GlRenderbuffer = GlObject<GlKind::Renderbuffer>;
+using GlFramebuffer = GlObject<GlKind::Framebuffer>;
+using GlQuery = GlObject<GlKind::Query>;
@@ -0,0 +1,31 @@
+#pragma once
+#include <GL/glew.h>
+#include "include/utils/GlObject.hpp"
+
+// Measures how long the GPU spends on the commands between begin() and end() with GL_TIME_ELAPSED queries:
+// - Results are read a few frames later, only once the driver reports them available, so timing never stalls
+// - Only one timer may be between begin() and end() at a time (GL allows one elapsed-time query per target)
+// - Does nothing where timer queries are missing (GL 3.3 or ARB_timer_query)
+class GpuTimer {
+public:
+    static constexpr int LATENCY = 4; // Queries in flight
+
+    GlQuery queries[LATENCY];
+    bool pending[LATENCY];  // Ended, result not read yet
+    int next;               // Query the next begin() uses
+    bool active;            // Between begin() and end()
+    double milliseconds;    // Latest result, -1 until one arrives
+
+    // Factory method, creates the queries when the context supports them
+    static GpuTimer create();
+
+    bool supported() const;
+
+    // Brackets the timed commands. Skips the sample when every query is still waiting for its result.
+    void begin();
+    void end();
+
+private:
+    // Reads the results that have arrived, oldest first
+    void collect();
+};
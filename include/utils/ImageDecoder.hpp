@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Image decoding backends behind TextureUtils::decodeImage:
+// - A backend claims encoded data by its signature; the first that claims an image and decodes it wins
+// - libjpeg-turbo (SIMD IDCT and color conversion) takes JPEGs when built with -DSOLARSCOPE_TURBOJPEG -lturbojpeg
+// - libspng takes PNGs when built with -DSOLARSCOPE_SPNG -lspng; its inflate is zlib's, so linking zlib-ng
+//   (zlib-compatible build) speeds it up further
+// - stb_image always comes last and decodes everything else, with its SSE2 / NEON JPEG paths where the CPU has them
+// Pixels are 8-bit, row-major from the top, allocated with malloc (release with TextureUtils::freeImage).
+struct ImageDecoder {
+    const char* name;
+    bool (*accepts)(const unsigned char* data, size_t size);
+    unsigned char* (*decode)(const unsigned char* data, size_t size, int* width, int* height, int* channels);
+
+    // Backends in the order they are tried
+    static const std::vector<ImageDecoder>& all();
+
+    // Puts a backend ahead of the built-in ones; call before any decoding starts
+    static void add(const ImageDecoder& decoder);
+
+    // Decodes with the first backend that accepts the data and succeeds, nullptr when none does (or data is
+    // nullptr, for a file that could not be read). Safe to call from worker threads; decoderName (optional)
+    // receives the backend that succeeded.
+    static unsigned char* decodeAny(const unsigned char* data, size_t size, int* width, int* height, int* channels,
+                                    const char** decoderName = nullptr);
+
+    // Why the last decodeAny on this thread failed
+    static const char* failureReason();
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "include/utils/GlObject.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Central account of the memory the renderer holds on purpose:
+// - GPU: bytes per buffer, texture and renderbuffer, recorded when storage is (re)allocated and dropped when the
+//   object is deleted (GlObject does this automatically)
+// - CPU: mapped caches and other long-lived allocations, added and removed by their owners
+// - Optional GPU and CPU budgets (--gpu-budget, --cpu-budget); crossing one prints a warning with the
+//   per-category breakdown, once until usage drops back under it
+class MemoryBudget {
+public:
+    enum Category { Geometry, Textures, Instances, Uniforms, Framebuffers, Caches, CATEGORY_COUNT };
+
+    // Storage of a GL object is now bytes; replaces whatever was recorded for it before
+    static void trackGpu(GlKind kind, GLuint name, Category category, size_t bytes);
+    static void releaseGpu(GlKind kind, GLuint name);
+
+    // Long-lived CPU memory, negative bytes when it is freed
+    static void trackCpu(Category category, int64_t bytes);
+
+    // 0 disables a budget
+    static void setBudgets(size_t gpuBytes, size_t cpuBytes);
+
+    static size_t gpuBytes();
+    static size_t cpuBytes();
+    static const char* categoryName(Category category);
+
+    // Usage per category and against the budgets
+    static void report(std::ostream& out);
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <GL/glew.h>
+
+// Thin cache over the OpenGL state the renderer touches every frame:
+// - Remembers bound program, VAO, textures, blend, cull, depth and point size state
+// - Skips calls that would set a value that is already current
+// - Counts issued and skipped calls so redundant state changes are visible
+// All draw code should go through this class instead of calling glUseProgram/glEnable/... directly,
+// otherwise the cache and the driver disagree.
+class RenderState {
+public:
+    static constexpr int MAX_TEXTURE_UNITS = 16;
+
+    struct Counters {
+        unsigned int issued;  // State calls forwarded to the driver
+        unsigned int skipped; // Redundant state calls avoided
+    };
+
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void bindTexture(GLenum target, GLuint texture, GLuint unit = 0);
+
+    static void setBlend(bool enabled);
+    static void setBlendFunc(GLenum srcFactor, GLenum dstFactor);
+    static void setCullFace(bool enabled);
+    static void setDepthTest(bool enabled);
+    static void setDepthFunc(GLenum func);
+    static void setDepthMask(bool enabled);
+    static void setPolygonMode(GLenum mode);
+    static void setProgramPointSize(bool enabled); // Vertex shaders set gl_PointSize
+
+    // Reversed-Z depth: setDepthFunc flips its comparison (LESS <-> GREATER, LEQUAL <-> GEQUAL),
+    // so renderers keep asking for the standard functions in every depth mode
+    static void setReversedDepth(bool enabled);
+
+    // Forget a deleted object: GL unbinds it and may hand its name to the next object created, which must
+    // not be mistaken for already bound
+    static void forgetTexture(GLuint texture);
+    static void forgetVertexArray(GLuint vao);
+
+    // Forget everything cached (use after code that changed GL state behind the cache's back)
+    static void invalidate();
+
+    // Returns the counters for the frame that just finished and starts a new frame
+    static Counters endFrame();
+
+    // Routes driver errors to stderr through KHR_debug (debug builds only, replaces glGetError polling)
+    static void installDebugCallback();
+};
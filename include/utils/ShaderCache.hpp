@@ -0,0 +1,46 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Linked shader programs, one per vertex/fragment pair and feature set, compiled on first use:
+// - Sources come from the asset pack when it holds them, else from the copies compiled into the executable
+//   (EmbeddedShaders.hpp), and only as a last resort from loose files
+// - #include "file" pulls in another source, relative to the including file and at most once per stage
+// - The global defines (depth mode) and the requested features are defined right after #version, so each
+//   permutation compiles only the code it uses instead of branching on uniforms per fragment
+class ShaderCache {
+public:
+    enum Feature : uint32_t {
+        SUN = 1,        // Self-lit star
+        SHADOWS = 2,    // Bodies in the SceneData block cast shadows
+        ATMOSPHERE = 4, // Rim glow tinted by the surface
+    };
+    static constexpr int FEATURE_COUNT = 3;
+
+    // Program for the pair with the given features, compiled and linked the first time it is asked for
+    static GLuint get(const std::string& vertexPath, const std::string& fragmentPath, uint32_t features = 0);
+
+    // Source ready for glShaderSource: includes expanded, defines inserted; empty when it cannot be found
+    static std::string preprocess(const std::string& path, uint32_t features = 0);
+
+    // Defines inserted into every shader compiled after this call (e.g. "#define LOG_DEPTH\n" for the depth mode)
+    static void setDefines(const std::string& defines);
+
+    // Called with every newly linked program, for uniforms that are set once (SceneData is bound automatically)
+    static void setLinkCallback(std::function<void(GLuint)> callback);
+
+    // Programs linked so far
+    static size_t size();
+};
+
+// A vertex/fragment pair whose permutations are looked up in ShaderCache once, then served from this table
+struct ShaderVariants {
+    std::string vertexPath;
+    std::string fragmentPath;
+    GLuint programs[1 << ShaderCache::FEATURE_COUNT] = {};
+
+    GLuint get(uint32_t features);
+};
@@ -5,34 +5,9 @@
 
 class ShaderUtils {
 public:
-    static std::string readFile(const char* filePath);
-    
-    // Basic shader sources
-    static std::string getVertexShaderSource();
-    static std::string getFragmentShaderSource();
-    
-    // Selection shader sources
-    static std::string getSelectionVertexShaderSource();
-    static std::string getSelectionFragmentShaderSource();
-    
-    // Skybox shader sources
-    static std::string getSkyboxVertexShaderSource();
-    static std::string getSkyboxFragmentShaderSource();
-    
-    // Textured sphere shader sources
-    static std::string getTexturedSphereVertexShaderSource();
-    static std::string getTexturedSphereFragmentShaderSource();
-    
-    // UI shader sources
-    static std::string getUIVertexShaderSource();
-    static std::string getUIFragmentShaderSource();
-    
-    // Shader compilation methods
-    static int compileVertexAndFragShaders();
-    static unsigned int compileSkyboxShaderProgram();
-    static GLuint compileTexturedSphereShader();
-    static GLuint compileUIShader();
-    
-    // Setup all shader programs
+    // Compiles and links a vertex/fragment pair, logging any errors
+    static GLuint compileProgram(const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Setup all shader programs (through ShaderCache, which owns their sources)
     static ShaderPrograms setupShaderPrograms();
 };
@@ -2,9 +2,18 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <GL/glew.h>
+#include "include/utils/GlObject.hpp"
 
 class SphereUtils {
 public:
+    // Indexed geometry with positions (attribute 0) and UVs (attribute 1), freed with its owner
+    struct Buffers {
+        GlVertexArray vao;
+        GlBuffer positions;
+        GlBuffer uvs;
+        GlBuffer indices;
+    };
+
     static void generateSphereVerticesAndUVs(unsigned int rings,
                                            unsigned int sectors,
                                            std::vector<glm::vec3>& vertices,
@@ -14,11 +23,12 @@ public:
                                     unsigned int sectors,
                                     std::vector<unsigned int>& indices);
                                     
-    static GLuint setupSphereBuffers(const std::vector<glm::vec3>& vertices,
-                                    const std::vector<glm::vec2>& uvs,
-                                    const std::vector<unsigned int>& indices);
-                                    
-    static GLuint createTexturedSphereVAO(unsigned int rings,
-                                         unsigned int sectors,
-                                         unsigned int& indexCount);
+    static Buffers setupSphereBuffers(const std::vector<glm::vec3>& vertices,
+                                      const std::vector<glm::vec2>& uvs,
+                                      const std::vector<unsigned int>& indices);
+
+    // Unit sphere with the given tessellation, built on first use and shared by every caller (SphereUtils owns it)
+    static GLuint texturedSphereVAO(unsigned int rings,
+                                    unsigned int sectors,
+                                    unsigned int& indexCount);
 };
@@ -0,0 +1,23 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// Textures shared by path: every mesh, body or ring that names the same image gets the same GL texture
+// - Paths are normalized, so "models/a/../a/x.png" and "models/a/x.png" are one entry
+// - preload() decodes all images not loaded yet in parallel, then uploads them on the calling (GL) thread
+// - A failed load is remembered as 0 and not retried
+// - The cache owns the textures, clear() deletes them all (users must not hold on to the names)
+class TextureCache {
+public:
+    // Texture for the image at path, loaded on first use
+    static GLuint get(const std::string& path);
+
+    // Loads every image in paths that is not cached yet (empty paths are skipped), decoding them on worker threads
+    static void preload(const std::vector<std::string>& paths);
+
+    // Distinct images loaded so far
+    static size_t size();
+
+    static void clear();
+};
@@ -1,9 +1,21 @@
 #pragma once
 #include <GL/glew.h>
+#include <glm/glm.hpp>
 #include <string>
 #include <iostream>
 
 class TextureUtils {
 public:
     static GLuint loadTexture(const char* path);
+
+    // 8-bit pixels decoded from the asset pack, or the loose file when the pack lacks it, by the first
+    // ImageDecoder backend that handles the format; free with freeImage. Safe to call from worker threads.
+    static unsigned char* decodeImage(const char* path, int* width, int* height, int* channels);
+    static void freeImage(unsigned char* pixels);
+
+    // Mipmapped, repeating texture from decoded 8-bit pixels (3 or 4 channels)
+    static GLuint uploadTexture(const unsigned char* pixels, int width, int height, int channels);
+
+    // Average color of a mipmapped texture, read back from its 1x1 top mip level
+    static glm::vec3 averageColor(GLuint texture);
 };
@@ -0,0 +1,51 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "include/space_objects/CelestialBody.hpp"
+#include "include/utils/GlObject.hpp"
+#include "include/world/FloatingOrigin.hpp"
+
+// Fallback for bodies smaller than a pixel on screen:
+// - A body whose projected radius drops below MIN_PIXEL_RADIUS is collected here instead of drawing its sphere
+// - All collected bodies go out in one GL_POINTS draw, one vertex each
+// - Brightness follows reflected sunlight: size, albedo (average texture color) and distance to the sun
+class BodyPoints {
+public:
+    static constexpr float MIN_PIXEL_RADIUS = 1.0f;
+
+    struct Point {
+        glm::vec3 position; // Render space, relative to the floating origin
+        glm::vec3 color;  // Hue of the body, normalized so the brightest channel is 1
+        float logFlux;    // ln of reflected light relative to a 1 pixel body at the reference sun distance
+    };
+
+    GlVertexArray vao;
+    GlBuffer vbo;
+    GLsizeiptr capacity;         // Bytes allocated in vbo
+    float referenceSunDistance;  // Sun distance that receives full sunlight (Earth's orbit)
+    float viewportHeight;        // Pixels, converts projected size to screen size
+    std::vector<Point> points;   // Bodies collected this frame
+
+    // Factory method to allocate the point buffer
+    static BodyPoints create(float referenceSunDistance, float viewportHeight);
+
+    // Radius of a sphere on screen, in pixels
+    float projectedPixelRadius(const glm::dvec3& position,
+                               float radius,
+                               const glm::dvec3& eyePosition,
+                               const glm::mat4& projectionMatrix) const;
+
+    // Collects the body if it is sub-pixel; returns false when it should be drawn as a sphere instead
+    bool add(const CelestialBody& body,
+             const glm::dvec3& sunPosition,
+             const glm::dvec3& eyePosition,
+             const FloatingOrigin& origin,
+             const glm::mat4& projectionMatrix);
+
+    // Starts a new frame's collection
+    void clear();
+
+    // Uploads the collected points and draws them with additive blending
+    void render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+};
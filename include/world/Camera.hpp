@@ -9,7 +9,7 @@ class CelestialBody;  // Forward declaration
 
 class Camera {
 public:
-    glm::vec3 position;         // Camera position in 3D space
+    glm::dvec3 position;        // Camera position in world space, also the floating origin for rendering
     glm::vec3 lookAt;           // Direction the camera is facing
     glm::vec3 up;              // Up vector for camera orientation
     float speed;               // Normal movement speed
@@ -20,7 +20,7 @@ public:
 
     // Constructor with default values can be added here
     Camera() : 
-        position(glm::vec3(0.0f, 2.0f, 5.0f)),
+        position(glm::dvec3(0.0, 2.0, 5.0)),
         lookAt(glm::vec3(0.0f, 0.0f, -1.0f)),
         up(glm::vec3(0.0f, 1.0f, 0.0f)),
         speed(6.0f),
@@ -39,6 +39,9 @@ public:
     // Update camera position based on keyboard input
     void updatePosition(class GLFWwindow* window, float dt);
     
-    // Get view matrix based on camera state
+    // Eye position in world space (behind position in third-person)
+    glm::dvec3 eyePosition() const;
+
+    // Get view matrix based on camera state, relative to position (the floating origin)
     glm::mat4 updateViewMatrix() const;
 };
@@ -0,0 +1,43 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <string>
+#include "include/utils/GlObject.hpp"
+#include "include/world/LaunchOptions.hpp"
+
+// Depth precision for huge near/far ratios (--depth), chosen once at startup:
+// - Standard: the window's fixed-point depth buffer with OpenGL's [-1, 1] clip range (near 0.01, far 100)
+// - Reversed: near maps to 1 and far to 0 with glClipControl(ZERO_TO_ONE) in a 32-bit float depth attachment,
+//   the float exponent cancels the 1/z crowding; the frame is blitted to the window at the end
+// - Logarithmic: fragment depth = log2(1 + w) / log2(1 + far), needs no extension
+// Reversed-Z needs GL 4.5 or ARB_clip_control and falls back to logarithmic depth without it (e.g. on macOS)
+class DepthBuffer {
+public:
+    LaunchOptions::DepthMode mode;
+    float nearPlane;
+    float farPlane;
+    int width, height;   // Framebuffer size in pixels
+    GlFramebuffer framebuffer;  // Offscreen target for reversed-Z (0 = draw straight to the window)
+    GlRenderbuffer colorBuffer;
+    GlRenderbuffer depthBuffer;
+
+    // Factory method: resolves the requested mode against the context and allocates the offscreen target
+    static DepthBuffer create(LaunchOptions::DepthMode requested, int width, int height);
+
+    // Perspective projection matching the mode's clip convention
+    glm::mat4 projection(float fovy, float aspect) const;
+
+    // Preprocessor defines the shaders need for this mode (REVERSED_Z or LOG_DEPTH)
+    std::string shaderDefines() const;
+
+    // Sets the logarithmic depth coefficient on a shader that writes log depth
+    void bindShader(GLuint shader) const;
+
+    // Binds the target and clears color and depth (far is 0.0 in reversed-Z)
+    void beginFrame() const;
+
+    // Copies the offscreen color to the window (no-op when drawing to the window directly)
+    void endFrame() const;
+
+    const char* name() const;
+};
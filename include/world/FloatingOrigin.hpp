@@ -0,0 +1,14 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Camera-relative rendering for double-precision simulation state:
+// - Bodies, the camera and the sun live in world space as doubles
+// - Everything sent to the GPU is first made relative to the origin (the camera position) and only then
+//   rounded to float, so precision is finest next to the viewer and true-scale distances do not jitter
+// - View matrices carry only the camera's rotation (plus the third-person offset), never its world position
+struct FloatingOrigin {
+    glm::dvec3 origin = glm::dvec3(0.0);
+
+    // World position to render space (float, relative to the origin)
+    glm::vec3 toRender(const glm::dvec3& worldPosition) const { return glm::vec3(worldPosition - origin); }
+};
@@ -6,26 +6,36 @@
 #include <algorithm>
 #include <iostream>
 #include "PlanetInfo.hpp"
+#include "TextRenderer.hpp"
 
+// Info panel drawn from the selected body's PlanetInfo text:
+// - Background, name, description and facts are one TextRenderer batch, a single draw call
+// - The batch is laid out again only when the shown info changes, not every frame
+// - Every body with a description gets a panel, no per-body artwork
 class InfoPanel {
 public:
+    static constexpr float WIDTH = 400.0f;
+    static constexpr float MARGIN = 20.0f;
+
     bool visible;
     bool wasIPressed;
     PlanetInfo currentInfo;
     float fadeAlpha;
-    GLuint currentTexture;         // Current planet info texture
-    std::vector<GLuint> planetTextures; // All planet info textures
-    std::vector<std::string> planetNames;    // Planet names for texture mapping
+    TextRenderer text;   // Panel layout
+    bool layoutPending;  // currentInfo changed since the last layout
 
-    InfoPanel();
-    void loadPlanetTextures();
+    // Factory method, builds the font atlas
+    static InfoPanel create();
     void show(const PlanetInfo& info);
     void hide();
     void toggle(const PlanetInfo& info);
+    // Advances the fade and lays out the panel when its text changed (GL thread)
     void update(float dt);
     void handleInput(GLFWwindow* window, const PlanetInfo& currentPlanetInfo);
-    
-    // Renders the semi-transparent background for the info panel
-    void renderBackground(GLuint shader, int windowWidth, int windowHeight) const;
+
+    // Renders the panel in the top-right corner
     void renderOnScreen(GLuint uiShader, int windowWidth, int windowHeight) const;
+
+private:
+    void layout();
 };
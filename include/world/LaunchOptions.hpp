@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+
+// Startup configuration parsed from the command line (--name=value):
+// --scene=<path>            Scene description with the bodies, orbits, textures and info text
+// --sky=cubemap|stars       Background: six-face cubemap or procedural starfield
+// --star-catalog=<path>     Binary star catalog used by --sky=stars
+// --bodies=mesh|impostor    Celestial bodies as UV sphere meshes or ray-traced impostors
+// --asteroids=<count>       Asteroids in the instanced belt between Mars and Jupiter (0 disables it, at most MAX_ASTEROIDS)
+// --small-bodies=<path>     Orbital-element catalog CSV (e.g. a JPL SBDB export) streamed in instead of the belt
+// --physics=scripted|barnes-hut|direct|ephemeris  Planet motion: scripted circles, Barnes-Hut or direct-summation
+//                           gravity, or real positions from the Chebyshev ephemeris cache
+// --theta=<angle>           Barnes-Hut opening angle (smaller is more accurate, larger is faster)
+// --date=YYYY-MM-DD         Start date for --physics=ephemeris (default: today)
+// --depth=standard|reversed|log  Depth buffer: 24-bit window depth, reversed-Z float depth, or logarithmic depth
+// --gpu-budget=<MB>         Warn when buffers, textures and framebuffers exceed this much GPU memory (0 = no limit)
+// --cpu-budget=<MB>         Warn when mapped caches and other long-lived CPU data exceed this much (0 = no limit)
+// --assets=<path>           Asset pack built by tools/make_asset_pack, read instead of loose files when present
+struct LaunchOptions {
+    static constexpr unsigned long MAX_ASTEROIDS = 5000000; // ~160 MB of belt instances
+    static constexpr unsigned long MAX_BUDGET_MB = 1048576;  // 1 TB
+
+    enum class SkyMode { Cubemap, Starfield };
+    enum class BodyMode { Mesh, Impostor };
+    enum class PhysicsMode { Scripted, BarnesHut, Direct, Ephemeris };
+    enum class DepthMode { Standard, Reversed, Logarithmic };
+
+    SkyMode skyMode = SkyMode::Cubemap;
+    BodyMode bodyMode = BodyMode::Mesh;
+    unsigned int asteroidCount = 20000;
+    PhysicsMode physicsMode = PhysicsMode::Scripted;
+    double theta = 0.5;
+    std::string startDate; // Empty starts at the current date
+    DepthMode depthMode = DepthMode::Standard;
+    std::string starCatalogPath = "textures/stars/bright_stars.bin";
+    std::string scenePath = "scenes/solar_system.scene";
+    std::string smallBodyCatalogPath; // Empty uses the generated belt
+    std::string assetPackPath = "assets.pack";
+    unsigned int gpuBudgetMB = 0;
+    unsigned int cpuBudgetMB = 0;
+
+    // Parses argv, warning about (and ignoring) anything it does not recognize
+    static LaunchOptions parse(int argc, char* argv[]);
+};
@@ -15,4 +15,6 @@ struct PlanetInfo {
         facts[1] = f2;
         facts[2] = f3;
     }
+
+    bool operator==(const PlanetInfo& other) const = default;
 };
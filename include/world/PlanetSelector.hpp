@@ -5,7 +5,9 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include "include/space_objects/CelestialBody.hpp"
+#include "include/world/FloatingOrigin.hpp"
 #include "include/world/PlanetInfo.hpp"
+#include "include/world/SceneFile.hpp"
 
 class PlanetSelector {
 public:
@@ -25,8 +27,10 @@ public:
     // Render selection indicator for the currently selected planet
     void renderSelectionIndicator(GLuint shader,
                                 const glm::mat4& viewMatrix,
-                                const glm::mat4& projectionMatrix) const;
+                                const glm::mat4& projectionMatrix,
+                                const FloatingOrigin& origin) const;
                                 
-    // Setup planet selector with detailed information
-    static PlanetSelector setupWithInfo(std::vector<CelestialBody*>& allBodies);
+    // Setup planet selector with the scene's selection order and info text
+    // sceneBodies holds one body per scene entry, in scene order
+    static PlanetSelector setupWithInfo(const SceneFile& scene, const std::vector<CelestialBody*>& sceneBodies);
 };
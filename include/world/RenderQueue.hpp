@@ -0,0 +1,49 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Collects the frame's draws as packets and runs them in one sorted pass:
+// - Opaque packets sort by shader, then coarse front-to-back depth, then texture, then fine depth: state changes
+//   stay grouped while near bodies still draw before the far ones they may hide (early-Z rejects hidden pixels)
+// - Sky packets run after opaque geometry so only uncovered pixels are shaded
+// - Transparent packets sort back-to-front so blending composites correctly
+// - Overlay packets (selection indicator, UI) run last in submission order
+//
+// Depth is logarithmic over [nearDistance, farDistance], so a camera next to a moon and one across the system both
+// spread their bodies over the key range. The opaque bucket is the top 4 bits of the same depth.
+//
+// Sort key layout, most significant bits first:
+//   Opaque:      | pass:3 | shader:10 | bucket:4 | texture:16 | depth:24 | unused:7 |
+//   Transparent: | pass:3 | ~depth:24 | shader:10  | texture:16 | unused:11 |
+//   Sky/Overlay: | pass:3 | zero (stable sort keeps submission order)    |
+class RenderQueue {
+public:
+    enum Pass : uint64_t {
+        Opaque = 0,
+        Sky = 1,
+        Transparent = 2,
+        Overlay = 3
+    };
+
+    struct DrawPacket {
+        uint64_t sortKey;
+        std::function<void()> draw;
+    };
+
+    std::vector<DrawPacket> packets;
+    float nearDistance; // View distance mapped to depth key 0
+    float farDistance;  // View distance mapped to the largest depth key
+
+    // Use the projection's near and far planes
+    RenderQueue(float nearDistance, float farDistance);
+
+    // Builds a sort key from the packet's pass, state and distance from the camera
+    uint64_t makeKey(Pass pass, GLuint shader, GLuint texture, float viewDistance) const;
+
+    void submit(uint64_t sortKey, std::function<void()> draw);
+
+    // Sorts and executes every packet, then empties the queue for the next frame
+    void flush();
+};
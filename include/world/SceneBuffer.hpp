@@ -0,0 +1,33 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "include/utils/GlObject.hpp"
+
+// Per-frame scene data shared by every celestial body draw:
+// - Shadow casters (xyz = camera-relative position, w = radius) packed into a std140 uniform block
+// - Written once per frame instead of once per body
+// - Ring of buffer slices guarded by fences so the CPU never overwrites data the GPU is still reading
+class SceneBuffer {
+public:
+    static constexpr GLuint BINDING_POINT = 0;
+    static constexpr int MAX_BODIES = 1023;      // Must match MAX_SCENE_BODIES in the sphere fragment shaders
+    static constexpr int FRAMES_IN_FLIGHT = 3;   // Triple buffering
+
+    GlBuffer ubo;                     // Uniform buffer holding all slices
+    GLsizeiptr sliceSize;             // Size of one slice, rounded up to the offset alignment
+    int currentSlice;                 // Slice written this frame
+    GLsync fences[FRAMES_IN_FLIGHT];  // Signalled when the GPU is done with each slice
+
+    // Factory method to allocate the ring of uniform buffer slices
+    static SceneBuffer create();
+
+    // Connects a shader's SceneData block to the shared binding point
+    static void bindShader(GLuint shader);
+
+    // Uploads this frame's shadow casters and binds the slice for drawing
+    void update(const std::vector<glm::vec4>& bodies);
+
+    // Fences the current slice and advances to the next one (call after the last draw of the frame)
+    void endFrame();
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Data-driven scene description: bodies, hierarchy, orbits, textures and info panel text
+// - Edited as text (scenes/*.scene, format documented at the top of scenes/solar_system.scene)
+// - Compiled into a versioned binary of fixed-size records plus a string table, which is memory-mapped and read
+//   in place: no parsing at startup, and a new system needs a new scene file instead of a rebuild
+// - load() recompiles the binary whenever the text is newer, so edits show up on the next launch
+// - tools/compile_scene.cpp compiles ahead of time, e.g. to ship only the binary
+// File layout: FileHeader, BodyRecord[bodyCount], uint32 selection[selectionCount], string table
+class SceneFile {
+public:
+    static constexpr uint32_t VERSION = 2;
+    static constexpr int FACT_COUNT = 3;
+
+    enum Kind : uint32_t { Star, Planet, Moon, Comet };
+    enum Flags : uint32_t { HAS_COMPARISON = 1, HAS_RINGS = 2, AIRLESS = 4 };
+
+    struct FileHeader {
+        char magic[4];          // "SSCN"
+        uint32_t version;
+        int64_t sourceTime;     // Modification time and size of the text it was compiled from
+        uint64_t sourceSize;
+        uint32_t bodyCount;
+        uint32_t selectionCount;
+        uint32_t stringBytes;
+        int32_t referenceBody;  // Body whose orbit sets the time, brightness and gravity units
+        float beltInner;        // Asteroid belt radii, 0 = no belt
+        float beltOuter;
+    };
+
+    // Strings are byte offsets into the string table; offset 0 is the empty string
+    struct BodyRecord {
+        uint32_t name;
+        uint32_t texture;
+        uint32_t description;
+        uint32_t facts[FACT_COUNT];
+        uint32_t ringTexture;
+        int32_t parent;              // Index of an earlier body, -1 for roots
+        uint32_t kind;               // Kind
+        uint32_t flags;              // Flags
+        int32_t ephemeris;           // KeplerianElements::Body, -1 when only scripted orbits apply
+        float radius;                // Render scale
+        float orbitRadius;           // Scripted orbit radius around the parent (semi-major axis for comets)
+        float orbitSpeed;            // Scripted orbit speed (mean motion in radians per second for comets)
+        float rotationSpeed;         // Degrees per second, negative is retrograde
+        float eccentricity;          // Comets
+        float startAngle;            // Comets, degrees along the orbit
+        float mass;                  // Solar masses, 0 keeps the body out of the gravity simulation
+        float position[3];           // Roots: world position (orbit center for comets)
+        float comparison[3];         // Position in size comparison mode (HAS_COMPARISON)
+        float ring[4];               // Inner and outer radius, tilt in degrees, radial scale (HAS_RINGS)
+    };
+
+    const unsigned char* data = nullptr; // Mapped file
+    size_t size = 0;
+
+    // Maps the compiled scene, compiling scenePath into binaryPath first when the binary is missing, stale or from
+    // another version. Without the text, an existing binary is used as is.
+    static SceneFile load(const std::string& scenePath, const std::string& binaryPath);
+
+    // Parses the text scene and writes the binary, reporting errors as path:line
+    static bool compile(const std::string& scenePath, const std::string& binaryPath);
+
+    // Binary path used for a scene by default: cache/<scene name>.sscn
+    static std::string cachePath(const std::string& scenePath);
+
+    bool valid() const { return data != nullptr; }
+
+    const FileHeader& header() const { return *reinterpret_cast<const FileHeader*>(data); }
+    uint32_t bodyCount() const { return header().bodyCount; }
+    const BodyRecord& body(uint32_t index) const;
+    uint32_t selectionCount() const { return header().selectionCount; }
+    uint32_t selection(uint32_t index) const; // Body index of the index-th entry in the selection cycle
+    const char* string(uint32_t offset) const;
+
+    // Index of the body with the given name, -1 if there is none
+    int find(const std::string& name) const;
+
+    void close();
+};
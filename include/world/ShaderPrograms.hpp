@@ -1,9 +1,15 @@
 #pragma once
+#include "../utils/ShaderCache.hpp"
 
 struct ShaderPrograms {
     int base;
     unsigned int skybox;
-    unsigned int orb;
-    unsigned int ui;
+    unsigned int orb;        // Lit textured mesh with shadows and atmosphere (planet rings)
+    unsigned int ui;         // Screen-space text and panels (TextRenderer)
     unsigned int selection;  // For selection indicator
+    unsigned int starfield;  // Procedural sky point sprites
+    unsigned int bodyPoints; // Sub-pixel bodies as point sprites
+    unsigned int asteroids;  // Instanced asteroid belt
+    ShaderVariants bodies;        // Celestial body meshes, one program per ShaderCache feature set
+    ShaderVariants bodyImpostors; // Ray-traced sphere impostors (--bodies=impostor)
 };
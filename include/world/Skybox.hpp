@@ -3,16 +3,17 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include "include/utils/GlObject.hpp"
 
 // Manages the space background environment:
-// - Creates a skybox cube with 6 textured faces
 // - Handles cubemap texture loading
-// - Renders the environment around the scene
+// - Renders the environment as one full-screen triangle after opaque geometry,
+//   reconstructing view rays in the vertex shader and drawing at the far plane
+//   so the depth test rejects every pixel already covered by a planet
 class Skybox {
 public:
-    GLuint vao;     // Vertex Array Object for the cube
-    GLuint vbo;     // Vertex Buffer Object
-    GLuint texture; // Texture ID
+    GlVertexArray vao; // Empty Vertex Array Object (vertices come from gl_VertexID)
+    GlTexture texture; // Cubemap
 
     // Factory method to create a skybox
     static Skybox create(const std::vector<std::string>& faces);
@@ -22,5 +23,5 @@ public:
 
 private:
     // Helper method to load cubemap textures
-    static unsigned int loadCubemap(const std::vector<std::string>& faces);
+    static GlTexture loadCubemap(const std::vector<std::string>& faces);
 };
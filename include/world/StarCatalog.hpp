@@ -0,0 +1,27 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One catalog entry, 8 bytes both on disk and in the GPU vertex buffer
+struct StarRecord {
+    int16_t direction[3]; // Unit vector toward the star, scaled by 32767
+    uint8_t magnitude;    // Apparent visual magnitude, stored as (mag + 2) * 20
+    uint8_t colorIndex;   // B-V color index, stored as (bv + 0.5) * 100
+};
+
+// Compact binary star catalog: "SSTR" magic, uint32 version, uint32 count, then packed StarRecords
+// - A few thousand naked-eye stars fit in tens of kilobytes
+// - tools/make_star_catalog.cpp converts a CSV catalog (e.g. HYG or the Yale Bright Star Catalog) into this format
+namespace StarCatalog {
+    const uint32_t VERSION = 1;
+
+    StarRecord makeRecord(const glm::vec3& direction, float magnitude, float colorIndex);
+
+    bool load(const std::string& path, std::vector<StarRecord>& stars);
+    bool save(const std::string& path, const std::vector<StarRecord>& stars);
+
+    // Deterministic stand-in sky (galactic band, realistic magnitude counts) for when no catalog file is present
+    std::vector<StarRecord> generate(unsigned int count, unsigned int seed);
+}
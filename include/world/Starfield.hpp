@@ -0,0 +1,22 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <string>
+#include "include/utils/GlObject.hpp"
+
+// Procedural alternative to the cubemap Skybox:
+// - Loads a compact star catalog (see StarCatalog) straight into a vertex buffer
+// - Draws every star as a point sprite in a single call, sized and tinted from magnitude and color index
+// - Resolution independent and no texture memory, only 8 bytes per star
+class Starfield {
+public:
+    GlVertexArray vao;      // Vertex Array Object for the star points
+    GlBuffer vbo;           // Packed StarRecords
+    unsigned int starCount; // Number of stars in the buffer
+
+    // Factory method, generates a synthetic catalog when the file is missing
+    static Starfield create(const std::string& catalogPath);
+
+    // Renders the stars at the far plane with additive blending
+    void render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) const;
+};
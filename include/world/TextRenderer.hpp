@@ -0,0 +1,54 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <string>
+#include <vector>
+#include "include/utils/GlObject.hpp"
+
+// Screen text drawn from a signed distance field font:
+// - The glyphs are a built-in 5x7 bitmap font (printable ASCII plus ° and ³), turned into a small single-channel
+//   distance field atlas at startup, so panels need no font files or prebaked images
+// - Distances are exact for the union of the glyph's pixel squares, so edges stay crisp at any size
+// - Text and flat panels are laid out into one vertex buffer; upload() only runs when the layout changed and
+//   render() is a single draw call
+// Layout coordinates are pixels from the top-left of the block, y growing down.
+class TextRenderer {
+public:
+    struct Vertex {
+        glm::vec2 position;
+        glm::vec2 texCoord;
+        glm::u8vec4 color;
+    };
+
+    GlTexture atlas;              // R8 distance field, 0.5 on glyph edges
+    GlVertexArray vao;
+    GlBuffer vbo;
+    std::vector<Vertex> vertices; // Layout built since clear(), kept to reuse its capacity
+    GLsizei vertexCount;          // Vertices in the buffer
+    size_t bufferBytes;           // Buffer capacity
+
+    // Factory method, builds the atlas and an empty buffer
+    static TextRenderer create();
+
+    // Glyph cell metrics for text drawn at the given pixel size of one font pixel
+    static float advance(float size);
+    static float lineHeight(float size);
+
+    // Starts a new layout
+    void clear();
+
+    // Solid rectangle, returns its first vertex for resizeRect()
+    size_t addRect(float x, float y, float width, float height, const glm::vec4& color);
+    void resizeRect(size_t firstVertex, float width, float height);
+
+    // Text starting with its top-left at (x, y), wrapped between words at maxWidth and at '\n'; UTF-8, characters
+    // outside the font are drawn as '?'. Returns the y below the last line.
+    float addText(const std::string& text, float x, float y, float size, float maxWidth, const glm::vec4& color);
+
+    // Sends the layout to the vertex buffer
+    void upload();
+
+    // Draws the uploaded layout with its top-left at origin, in window pixels with y up
+    void render(GLuint shader, const glm::mat4& projection, const glm::vec2& origin, float alpha) const;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <functional>
+
+// Simulation clock for time acceleration from 1x up to 10^6x:
+// - Simulation time is kept in double precision so analytic orbits stay exact after long time-lapses
+// - Dynamic bodies (comets, the gravity simulation) advance in adaptive substeps inside a per-frame compute budget
+// - When the budget runs out the clock advances less than requested and the effective rate is reported,
+//   so frames never stall
+class TimeController {
+public:
+    static constexpr double MAX_SPEED = 1e6;
+
+    double simTime = 0.0;          // Simulation seconds since start
+    double timeSpeed = 1.0;        // Requested rate, negative runs backwards
+    double budgetSeconds = 0.004;  // Wall-clock time per frame allowed for substeps
+    double effectiveSpeed = 1.0;   // Rate actually achieved over the last frame
+    unsigned int lastSubsteps = 0; // Substeps taken in the last frame
+    bool limited = false;          // Last frame ran out of budget before reaching the requested time
+
+    // Advances the clock by frameDt * timeSpeed and returns the simulation time actually covered.
+    // stepSize(remaining) gives the next substep length (positive, at most remaining),
+    // step(h) advances every dynamic body by h (negative when running backwards).
+    double advance(double frameDt,
+                   const std::function<double(double)>& stepSize,
+                   const std::function<void(double)>& step);
+
+    // Speed ladder: x1.5 steps up to 10x, then x10 steps up to MAX_SPEED
+    void faster();
+    void slower();
+    void reverse();
+    void reset();
+};
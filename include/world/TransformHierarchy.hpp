@@ -0,0 +1,53 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+#include "include/world/FloatingOrigin.hpp"
+
+// Parent/child transforms (star -> planet -> moon -> ring) stored as flat structure-of-arrays:
+// - Nodes are added parents-first, so index order is a topological order and update() is one linear pass
+// - Setters mark a node dirty only when the value changes; update() recomputes dirty nodes and their descendants
+// - Local rotation is a spin about Y after a tilt about X, composed with scale in closed form (no mat4 products)
+// - World translation stays double (see FloatingOrigin). Children always follow the parent's position,
+//   its rotation and scale only when asked: a moon does not swing around with its planet's spin
+class TransformHierarchy {
+public:
+    static constexpr int NO_PARENT = -1;
+    enum Inherit : unsigned char { TRANSLATION_ONLY = 0, INHERIT_ROTATION = 1, INHERIT_SCALE = 2 };
+
+    // Local transforms, indexed by node
+    std::vector<int> parent;
+    std::vector<unsigned char> inherit;
+    std::vector<glm::dvec3> translation; // Offset from the parent
+    std::vector<float> spin;             // Degrees about local Y
+    std::vector<float> tilt;             // Degrees about local X, applied before the spin
+    std::vector<glm::vec3> scale;
+    std::vector<unsigned char> dirty;    // Local value changed, or recomputed in the current update() pass
+
+    // World transforms, valid after update()
+    std::vector<glm::mat3> worldRotation;
+    std::vector<glm::vec3> worldScale;
+    std::vector<glm::dvec3> worldTranslation;
+
+    unsigned int lastUpdated = 0; // Nodes recomputed by the last update()
+
+    // Appends a node under parentNode (which must already exist) and returns its index
+    int add(int parentNode, unsigned char inheritFlags = TRANSLATION_ONLY);
+
+    size_t size() const { return parent.size(); }
+
+    void setTranslation(int node, const glm::dvec3& value);
+    void setRotation(int node, float spinDegrees, float tiltDegrees);
+    void setScale(int node, const glm::vec3& value);
+
+    // Recomputes world transforms for dirty subtrees
+    void update();
+
+    const glm::dvec3& worldPosition(int node) const { return worldTranslation[node]; }
+
+    // World matrix in render space (translation relative to the floating origin), built column by column
+    glm::mat4 renderMatrix(int node, const FloatingOrigin& origin) const;
+
+    // Spin about Y after tilt about X, same as rotate(Y, spin) * rotate(X, tilt)
+    static glm::mat3 rotation(float spinDegrees, float tiltDegrees);
+};
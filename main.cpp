@@ -3,6 +3,8 @@
 #include <glm/common.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <list>
 #include <string>
@@ -12,29 +14,49 @@
 #include <assimp/scene.h>
 
 #define GLEW_STATIC 1
-#define STB_IMAGE_IMPLEMENTATION
-#include "include/stb_image.h"
 
 #include "include/models/Mesh.hpp"
 #include "include/models/Model.hpp"
 
+#include "include/physics/BarnesHut.hpp"
+#include "include/physics/DirectSummation.hpp"
+#include "include/physics/Ephemeris.hpp"
+#include "include/physics/NBodySystem.hpp"
+
+#include "include/space_objects/AsteroidBelt.hpp"
 #include "include/space_objects/BlackHole.hpp"
 #include "include/space_objects/CelestialBody.hpp"
 #include "include/space_objects/Comet.hpp"
 #include "include/space_objects/PlanetRing.hpp"
+#include "include/space_objects/SmallBodyCatalog.hpp"
 #include "include/space_objects/TrailPoint.hpp"
 
+#include "include/utils/AssetPack.hpp"
 #include "include/utils/GeometryUtils.hpp"
+#include "include/utils/GpuTimer.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include "include/utils/ShaderCache.hpp"
 #include "include/utils/ShaderUtils.hpp"
 #include "include/utils/SphereUtils.hpp"
+#include "include/utils/TextureCache.hpp"
 #include "include/utils/TextureUtils.hpp"
 
+#include "include/world/BodyPoints.hpp"
+#include "include/world/DepthBuffer.hpp"
 #include "include/world/Camera.hpp"
 #include "include/world/InfoPanel.hpp"
+#include "include/world/LaunchOptions.hpp"
 #include "include/world/PlanetInfo.hpp"
 #include "include/world/PlanetSelector.hpp"
+#include "include/world/RenderQueue.hpp"
+#include "include/world/SceneBuffer.hpp"
+#include "include/world/SceneFile.hpp"
 #include "include/world/ShaderPrograms.hpp"
 #include "include/world/Skybox.hpp"
+#include "include/world/Starfield.hpp"
+#include "include/world/TimeController.hpp"
+#include "include/world/TransformHierarchy.hpp"
 #include "include/world/Window.hpp"
 
 using namespace glm;
@@ -42,6 +64,10 @@ using namespace std;
 
 int main(int argc, char *argv[])
 {
+    LaunchOptions options = LaunchOptions::parse(argc, argv);
+    MemoryBudget::setBudgets(size_t(options.gpuBudgetMB) << 20, size_t(options.cpuBudgetMB) << 20);
+    AssetPack::mount(options.assetPackPath); // Loose files only when there is no pack
+
     // Initialize GLFW and OpenGL
     GLFWwindow *window = Window::initializeGLFW();
     if (!window)
@@ -51,20 +77,31 @@ int main(int argc, char *argv[])
 
     if (!Window::initializeOpenGL())
     {
+        markGlContextDestroyed();
         glfwTerminate();
         return -1;
     }
 
     // Enable OpenGL features
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_DEPTH_TEST);
+    RenderState::setCullFace(true);
+    RenderState::setDepthTest(true);
+
+    // Depth mode (--depth) decides the projection and the shader variants, so it comes before the shaders
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    DepthBuffer depthBuffer = DepthBuffer::create(options.depthMode, framebufferWidth, framebufferHeight);
+    ShaderCache::setDefines(depthBuffer.shaderDefines());
+    ShaderCache::setLinkCallback([&depthBuffer](GLuint program)
+                                 { depthBuffer.bindShader(program); });
+    std::cout << "Depth: " << depthBuffer.name() << ", near " << depthBuffer.nearPlane << ", far " << depthBuffer.farPlane
+              << std::endl;
 
     // Setup shaders and camera
     ShaderPrograms shaders = ShaderUtils::setupShaderPrograms();
     Camera camera; // Constructor handles setup
 
     // Setup projection and view matrices
-    mat4 projectionMatrix = glm::perspective(70.0f, 800.0f / 600.0f, 0.01f, 100.0f);
+    mat4 projectionMatrix = depthBuffer.projection(70.0f, 800.0f / 600.0f);
 
     mat4 viewMatrix = camera.updateViewMatrix();
 
@@ -76,108 +113,116 @@ int main(int argc, char *argv[])
     glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
 
     // Create scene objects
-    int vao = GeometryUtils::createVertexBufferObject();
+    GeometryUtils::VertexBuffers cube = GeometryUtils::createVertexBufferObject();
     Model duckModel = Model::loadFromFile("models/rubber_duck/scene.gltf");
 
-    // Setup celestial bodies with realistic proportions
-    // Using a scale where Earth = 0.3f as base reference
-
-    /// SUN - Center of the system
-    CelestialBody sun = CelestialBody::create("textures/planet/sun.jpg",
-                                      4.0f,   // Scale
-                                      0.0f,   // Orbit radius
-                                      0.0f,   // Orbit speed
-                                      15.0f);  // Rotation speed
-    sun.position = vec3(0.0f, 0.0f, -20.0f);
-
-    // MERCURY - Smallest planet, closest orbit
-    CelestialBody mercury = CelestialBody::create("textures/planet/mercury.jpg",
-                                                0.11f, // Small size
-                                                8.0f,  // Safe distance from sun (was 3.0f)
-                                                2.0f,  // Fastest orbital speed
-                                                35.0f  // Fast rotation
-    );
-
-    // VENUS - Second planet
-    CelestialBody venus = CelestialBody::create("textures/planet/venus.jpg",
-                                              0.28f, // Venus size
-                                              10.0f, // Safe distance from mercury (was 4.5f)
-                                              1.6f,  // Orbital speed
-                                              -12.0f // Slow retrograde rotation
-    );
-
-    // EARTH - Third planet
-    CelestialBody earth = CelestialBody::create("textures/planet/earth.jpg",
-                                              0.35f, // Earth size
-                                              12.0f, // Safe distance from venus (was 6.0f)
-                                              1.0f,  // Earth orbital speed reference
-                                              20.0f  // Earth rotation speed
-    );
-
-    // MOON - Orbits Earth
-    CelestialBody moon = CelestialBody::create("textures/planet/moon.jpg",
-                                             0.08f, // Small moon size
-                                             1.2f,  // Distance from Earth (increased from 1.0f)
-                                             4.0f,  // Fast orbit around Earth
-                                             5.0f   // Moon rotation
-    );
-
-    // MARS - Fourth planet
-    CelestialBody mars = CelestialBody::create("textures/planet/mars.jpg",
-                                             0.16f, // Mars size
-                                             15.0f, // Safe distance from Earth (was 7.5f)
-                                             0.8f,  // Slower orbital speed than Earth
-                                             18.0f  // Rotation speed
-    );
-
-    // JUPITER - Fifth planet, largest
-    CelestialBody jupiter = CelestialBody::create("textures/planet/jupiter.jpg",
-                                                3.36f, // Large size
-                                                20.0f, // Safe distance from Mars (was 10.0f)
-                                                0.5f,  // Slower orbital speed
-                                                30.0f  // Fast rotation speed
-    );
-
-    // SATURN - Sixth planet with rings
-    CelestialBody saturn = CelestialBody::create("textures/planet/saturn.jpg",
-                                               2.82f, // Large size
-                                               36.0f, // Increased distance from Jupiter to accommodate rings
-                                               0.35f, // Slow orbital speed
-                                               28.0f  // Fast rotation speed
-    );
-
-    // URANUS - Seventh planet
-    CelestialBody uranus = CelestialBody::create("textures/planet/uranus.jpg",
-                                               1.4f,  // Medium size
-                                               50.0f, // Increased distance from Saturn to avoid ring collision
-                                               0.25f, // Very slow orbital speed
-                                               -15.0f // Retrograde rotation
-    );
-
-    // NEPTUNE - Outermost planet
-    CelestialBody neptune = CelestialBody::create("textures/planet/neptune.jpg",
-                                                1.17f, // Medium size
-                                                55.0f, // Safe distance from Uranus (was 22.0f)
-                                                0.2f,  // Slowest orbital speed
-                                                18.0f  // Normal rotation speed
-    );
-
-    Comet halleysComet = Comet::create("textures/comet/comet.jpg", vec3(0.0f, 0.0f, -20.0f), 45.0f, 0.85f);
-
-    Comet comet2 = Comet::create("textures/comet/comet.jpg", vec3(0.0f, 0.0f, -20.0f), 25.0f, 0.7f);
-    comet2.orbitAngle = 180.0f; // Start on opposite side
-
-    // Create Saturn's rings
-    PlanetRing saturnRings = PlanetRing::createSaturnRings();
+    // Bodies, hierarchy, orbits, textures and info text come from the scene file (--scene)
+    SceneFile scene = SceneFile::load(options.scenePath, SceneFile::cachePath(options.scenePath));
+    int starIndex = -1;
+    for (uint32_t i = 0; scene.valid() && i < scene.bodyCount() && starIndex < 0; i++)
+    {
+        if (scene.body(i).kind == SceneFile::Star)
+        {
+            starIndex = int(i);
+        }
+    }
+    if (starIndex < 0 || scene.header().referenceBody < 0)
+    {
+        std::cerr << "Scene needs a star and a reference body: " << options.scenePath << std::endl;
+        markGlContextDestroyed();
+        glfwTerminate();
+        return -1;
+    }
+
+    // Decode every body and ring texture in parallel up front, the bodies below pick them up from the cache
+    vector<string> sceneTextures;
+    for (uint32_t i = 0; i < scene.bodyCount(); i++)
+    {
+        sceneTextures.push_back(scene.string(scene.body(i).texture));
+        sceneTextures.push_back(scene.string(scene.body(i).ringTexture));
+    }
+    TextureCache::preload(sceneTextures);
+
+    // One body per scene entry, in scene order; comet heads live inside their Comet
+    vector<CelestialBody> bodyStorage;
+    vector<Comet> comets;
+    bodyStorage.reserve(scene.bodyCount());
+    comets.reserve(scene.bodyCount());
+    vector<CelestialBody *> sceneBodies(scene.bodyCount());
+    vector<CelestialBody *> systemBodies;   // Everything but comets
+    vector<CelestialBody *> rootBodies;     // Stars
+    vector<CelestialBody *> orbitingBodies; // Planets and moons
+    vector<uint32_t> planetIndices;         // Bodies orbiting a root, positioned in world space by the simulation
+    vector<uint32_t> satelliteIndices;      // Bodies orbiting a planet, positioned relative to it
+    for (uint32_t i = 0; i < scene.bodyCount(); i++)
+    {
+        const SceneFile::BodyRecord &record = scene.body(i);
+        dvec3 position = dvec3(record.position[0], record.position[1], record.position[2]);
+        if (record.kind == SceneFile::Comet)
+        {
+            comets.push_back(Comet::create(scene.string(record.texture), position, record.orbitRadius, record.eccentricity));
+            Comet &comet = comets.back();
+            comet.body.scale = vec3(record.radius);
+            comet.body.rotationSpeed = record.rotationSpeed;
+            comet.body.atmosphere = !(record.flags & SceneFile::AIRLESS);
+            comet.meanMotion = record.orbitSpeed;
+            comet.orbitAngle = radians(double(record.startAngle));
+            sceneBodies[i] = &comet.body;
+            continue;
+        }
+
+        bodyStorage.push_back(CelestialBody::create(scene.string(record.texture),
+                                                    record.radius,
+                                                    record.orbitRadius,
+                                                    record.orbitSpeed,
+                                                    record.rotationSpeed));
+        CelestialBody &body = bodyStorage.back();
+        body.atmosphere = !(record.flags & SceneFile::AIRLESS);
+        sceneBodies[i] = &body;
+        systemBodies.push_back(&body);
+        if (record.parent < 0)
+        {
+            body.position = position;
+            rootBodies.push_back(&body);
+            continue;
+        }
+
+        // Initial layout: scripted orbits at time zero (parents come first in the scene)
+        body.update(sceneBodies[record.parent]->position, 0.0, 0.0f);
+        orbitingBodies.push_back(&body);
+        (scene.body(record.parent).parent < 0 ? planetIndices : satelliteIndices).push_back(i);
+    }
+    CelestialBody &sun = *sceneBodies[starIndex];
+    CelestialBody &reference = *sceneBodies[scene.header().referenceBody]; // Earth in the solar system
+
+    // Asteroid belt, orbits computed on the GPU. A real catalog (--small-bodies) replaces the generated rocks and
+    // streams into the same buffer once it is parsed, see below.
+    bool catalogBelt = !options.smallBodyCatalogPath.empty();
+    AsteroidBelt asteroidBelt = AsteroidBelt::create(scene.header().beltOuter > 0.0f && !catalogBelt ? options.asteroidCount : 0,
+                                                     scene.header().beltInner,
+                                                     scene.header().beltOuter,
+                                                     reference.orbitRadius,
+                                                     1801);
+    GpuTimer beltTimer = GpuTimer::create(); // Belt draw time, reported with P
+
+    // Rings, e.g. Saturn's
+    vector<PlanetRing> rings;
+    vector<uint32_t> ringOwners;
+    for (uint32_t i = 0; i < scene.bodyCount(); i++)
+    {
+        const SceneFile::BodyRecord &record = scene.body(i);
+        if (record.flags & SceneFile::HAS_RINGS)
+        {
+            rings.push_back(PlanetRing::create(scene.string(record.ringTexture), record.ring[0], record.ring[1]));
+            ringOwners.push_back(i);
+        }
+    }
 
     // Setup planet selector with detailed information
-    vector<CelestialBody *> allBodies =
-        {&sun, &mercury, &mars, &venus, &earth, &moon, &neptune, &uranus, &saturn, &jupiter};
-    PlanetSelector planetSelector = PlanetSelector::setupWithInfo(allBodies);
+    PlanetSelector planetSelector = PlanetSelector::setupWithInfo(scene, sceneBodies);
 
-    // Add info panel
-    InfoPanel infoPanel;
-    infoPanel.loadPlanetTextures();
+    // Add info panel, drawn from the selection's PlanetInfo text
+    InfoPanel infoPanel = InfoPanel::create();
 
 
     // Add planet selection mode flag
@@ -186,59 +231,69 @@ int main(int argc, char *argv[])
     // Store reset positions AFTER bodies are created but BEFORE any updates
     BlackHole blackHole = BlackHole::create();
 
-    // Now set up initial orbital positions for normal animation
-    mercury.update(sun.position, 0.0f, 0.0f);
-    venus.update(sun.position, 45.0f, 0.0f);
-    earth.update(sun.position, 90.0f, 0.0f);
-    mars.update(sun.position, 135.0f, 0.0f);
-    jupiter.update(sun.position, 180.0f, 0.0f);
-    saturn.update(sun.position, 225.0f, 0.0f);
-    uranus.update(sun.position, 270.0f, 0.0f);
-    neptune.update(sun.position, 315.0f, 0.0f);
-    moon.update(earth.position, 0.0f, 0.0f);
-
     // Store these as the RESET positions (what we return to with R key)
     blackHole.resetPositions.clear();
     blackHole.resetScales.clear();
-    blackHole.resetPositions.push_back(sun.position);
-    blackHole.resetScales.push_back(sun.scale);
-    blackHole.resetPositions.push_back(mercury.position);
-    blackHole.resetScales.push_back(mercury.scale);
-    blackHole.resetPositions.push_back(venus.position);
-    blackHole.resetScales.push_back(venus.scale);
-    blackHole.resetPositions.push_back(earth.position);
-    blackHole.resetScales.push_back(earth.scale);
-    blackHole.resetPositions.push_back(moon.position);
-    blackHole.resetScales.push_back(moon.scale);
-    blackHole.resetPositions.push_back(mars.position);
-    blackHole.resetScales.push_back(mars.scale);
-    blackHole.resetPositions.push_back(jupiter.position);
-    blackHole.resetScales.push_back(jupiter.scale);
-    blackHole.resetPositions.push_back(saturn.position);
-    blackHole.resetScales.push_back(saturn.scale);
-    blackHole.resetPositions.push_back(uranus.position);
-    blackHole.resetScales.push_back(uranus.scale);
-    blackHole.resetPositions.push_back(neptune.position);
-    blackHole.resetScales.push_back(neptune.scale);
-
-    // Setup skybox
-    std::vector<std::string> skyboxFaces = {"textures/skybox/1.png",
-                                            "textures/skybox/2.png",
-                                            "textures/skybox/3.png",
-                                            "textures/skybox/4.png",
-                                            "textures/skybox/5.png",
-                                            "textures/skybox/6.png"};
-    Skybox skybox = Skybox::create(skyboxFaces);
+    for (CelestialBody *body : systemBodies)
+    {
+        blackHole.resetPositions.push_back(body->position);
+        blackHole.resetScales.push_back(body->scale);
+    }
+
+    // Setup sky: cubemap skybox or procedural starfield, only the selected one is loaded
+    Skybox skybox = {};
+    Starfield starfield = {};
+    if (options.skyMode == LaunchOptions::SkyMode::Starfield)
+    {
+        starfield = Starfield::create(options.starCatalogPath);
+    }
+    else
+    {
+        std::vector<std::string> skyboxFaces = {"textures/skybox/1.png",
+                                                "textures/skybox/2.png",
+                                                "textures/skybox/3.png",
+                                                "textures/skybox/4.png",
+                                                "textures/skybox/5.png",
+                                                "textures/skybox/6.png"};
+        skybox = Skybox::create(skyboxFaces);
+    }
+
+    // Per-frame shadow caster data shared by all celestial body draws
+    SceneBuffer sceneBuffer = SceneBuffer::create();
+
+    // Sorted draw submission, depth keys span the projection's far plane
+    RenderQueue renderQueue(depthBuffer.nearPlane, depthBuffer.farPlane);
+
+    // Bodies below a pixel on screen are batched into one point draw, brightness relative to the reference orbit
+    BodyPoints bodyPoints = BodyPoints::create(reference.orbitRadius, 600.0f);
+
+    // Transform hierarchy, one node per scene body in scene order (parents first), then one per ring.
+    // Planets follow only the star's position; rings take their planet's size but keep their own tilt.
+    TransformHierarchy transforms;
+    for (uint32_t i = 0; i < scene.bodyCount(); i++)
+    {
+        sceneBodies[i]->transformNode = transforms.add(scene.body(i).parent);
+    }
+    vector<int> ringNodes;
+    for (uint32_t owner : ringOwners)
+    {
+        const float *ring = scene.body(owner).ring;
+        int node = transforms.add(sceneBodies[owner]->transformNode, TransformHierarchy::INHERIT_SCALE);
+        transforms.setRotation(node, 0.0f, ring[2]);
+        transforms.setScale(node, vec3(ring[3], 1.0f, ring[3]));
+        ringNodes.push_back(node);
+    }
+    vector<dvec3> satelliteOffsets(scene.bodyCount()); // Moons' local translation under their planet
 
     // Initialize animation variables
     float spinningCubeAngle = 0.0f;
-    float orbAngle = 0.0f;
+    double orbAngle = 0.0; // Simulation clock in degrees of Earth's orbit
     float orbRadius = 2.0f;
     float orbHeight = 1.0f;
     float orbSize = 0.2f;
 
     // Set up texture uniform for the base shader
-    glUseProgram(shaders.base);
+    RenderState::useProgram(shaders.base);
     glUniform1i(glGetUniformLocation(shaders.base, "texture1"), 0);
 
     // Initialize timing and input state
@@ -250,11 +305,101 @@ int main(int argc, char *argv[])
     bool comparisonMode = false;
     bool wasCPressed = false;
 
-    // Time control variables
-    float timeSpeed = 1.0f; // Normal speed = 1.0, faster = >1.0, slower = <1.0, reverse = negative
+    // Time control variables: speed from 1x to 10^6x, reverse = negative
+    TimeController timeController;
     bool wasEqualPressed = false;
     bool wasMinusPressed = false;
     bool wasTPressed = false;
+    bool wasPPressed = false;
+
+    // Gravity simulation (--physics): the sun and planets with a mass follow Newtonian orbits instead of scripted circles.
+    // Moons keep their scripted orbits around their planet, at scene scale they sit far outside its Hill sphere.
+    NBodySystem gravitySystem;
+    BarnesHut barnesHut(options.theta);
+    DirectSummation directSummation;
+    vector<CelestialBody *> gravityBodies;
+    vector<double> gravityMasses; // Solar masses
+    vector<bool> inGravity(scene.bodyCount(), false);
+    for (uint32_t i = 0; i < scene.bodyCount(); i++)
+    {
+        const SceneFile::BodyRecord &record = scene.body(i);
+        bool satellite = record.parent >= 0 && scene.body(record.parent).parent >= 0;
+        if (record.kind != SceneFile::Comet && !satellite && record.mass > 0.0f)
+        {
+            gravityBodies.push_back(sceneBodies[i]);
+            gravityMasses.push_back(record.mass);
+            inGravity[i] = true;
+        }
+    }
+    bool gravitySeeded = false;
+    double initialEnergy = 0.0;
+    auto seedGravity = [&]()
+    {
+        // The reference (Earth's) scripted orbit sets the units: 20 degrees per second of animation time at its radius
+        double earthRate = glm::radians(20.0);
+        gravitySystem.clear();
+        gravitySystem.gravitationalConstant = earthRate * earthRate * pow(double(reference.orbitRadius), 3.0);
+        double sunMass = scene.body(starIndex).mass;
+
+        for (size_t i = 0; i < gravityBodies.size(); i++)
+        {
+            // Start from the scripted layout with circular velocities, moving from +X toward +Z like the scripted orbits
+            CelestialBody *body = gravityBodies[i];
+            if (body != &sun)
+            {
+                body->update(sun.position, orbAngle, 0.0f);
+            }
+            dvec3 offset = dvec3(body->position - sun.position);
+            double radius = length(offset);
+            dvec3 velocity(0.0);
+            if (radius > 0.0)
+            {
+                double speed = sqrt(gravitySystem.gravitationalConstant * sunMass / radius);
+                velocity = dvec3(-offset.z, 0.0, offset.x) * (speed / radius);
+            }
+            gravitySystem.add(dvec3(body->position), velocity, gravityMasses[i]);
+        }
+        gravitySystem.removeMomentum();
+        initialEnergy = gravitySystem.totalEnergy();
+        gravitySeeded = true;
+    };
+
+    // Real ephemeris (--physics=ephemeris): planet positions from the Chebyshev cache, mapped onto the scene orbit radii.
+    // A second of simulation time covers as much of Earth's year as the scripted orbits do (one year per 18 s).
+    const double ephemerisDaysPerSecond = 365.25 / 18.0;
+    Ephemeris ephemeris;
+    OrbitScale orbitScale;
+    double ephemerisStartDate = Ephemeris::currentJulianDate();
+    if (options.physicsMode == LaunchOptions::PhysicsMode::Ephemeris)
+    {
+        ephemeris = Ephemeris::load("cache/ephemeris.bin", Ephemeris::julianDate(1800, 1, 1), Ephemeris::julianDate(2200, 1, 1));
+        if (!options.startDate.empty())
+        {
+            Ephemeris::parseDate(options.startDate, ephemerisStartDate);
+        }
+    }
+    for (uint32_t i : planetIndices)
+    {
+        int body = scene.body(i).ephemeris;
+        if (body >= 0)
+        {
+            orbitScale.addKnot(KeplerianElements::semiMajorAxis(KeplerianElements::Body(body)), sceneBodies[i]->orbitRadius);
+        }
+    }
+
+    // Small-body catalog: elements stay in AU and the shader compresses distances with the same knots as the planets.
+    // Parsed in the background on first use, then a chunk per frame goes into the belt's instance buffer.
+    SmallBodyCatalog smallBodies;
+    if (catalogBelt)
+    {
+        smallBodies = SmallBodyCatalog::open(options.smallBodyCatalogPath,
+                                             SmallBodyCatalog::defaultCachePath(options.smallBodyCatalogPath));
+        asteroidBelt.referenceRadius = 1.0f; // Earth's semi-major axis in AU
+        for (const auto &knot : orbitScale.knots)
+        {
+            asteroidBelt.distanceKnots.push_back(vec2(float(knot.first), float(knot.second)));
+        }
+    }
 
     // Input state tracking for X & R keys
     static bool wasXPressed = false;
@@ -288,10 +433,8 @@ int main(int argc, char *argv[])
         {
             if (!wasEqualPressed)
             {
-                timeSpeed *= 1.5f; // Increase speed by 50%
-                if (timeSpeed > 10.0f)
-                    timeSpeed = 10.0f; // Cap at 10x speed
-                std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
+                timeController.faster(); // +50% up to 10x, then 10x per press up to 10^6x
+                std::cout << "Time speed: " << timeController.timeSpeed << "x" << std::endl;
                 wasEqualPressed = true;
             }
         }
@@ -304,10 +447,8 @@ int main(int argc, char *argv[])
         {
             if (!wasMinusPressed)
             {
-                timeSpeed /= 1.5f; // Decrease speed
-                if (timeSpeed < -10.0f)
-                    timeSpeed = -10.0f; // Cap reverse speed
-                std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
+                timeController.slower(); // Decrease speed
+                std::cout << "Time speed: " << timeController.timeSpeed << "x" << std::endl;
                 wasMinusPressed = true;
             }
         }
@@ -320,8 +461,9 @@ int main(int argc, char *argv[])
         {
             if (!wasTPressed)
             {
-                timeSpeed *= -1.0f; // Reverse time direction
-                std::cout << "Time " << (timeSpeed < 0 ? "reversed" : "forward") << " at " << abs(timeSpeed)
+                timeController.reverse(); // Reverse time direction
+                std::cout << "Time " << (timeController.timeSpeed < 0 ? "reversed" : "forward") << " at "
+                          << abs(timeController.timeSpeed)
                           << "x speed" << std::endl;
                 wasTPressed = true;
             }
@@ -334,7 +476,7 @@ int main(int argc, char *argv[])
         // Reset to normal speed
         if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
         {
-            timeSpeed = 1.0f;
+            timeController.reset();
             std::cout << "Time speed reset to normal" << std::endl;
         }
 
@@ -426,26 +568,11 @@ int main(int argc, char *argv[])
                 // CRITICAL FIX: Capture CURRENT positions when X is pressed, not stored positions
                 blackHole.originalPositions.clear();
                 blackHole.originalScales.clear();
-                blackHole.originalPositions.push_back(sun.position); // Current sun position
-                blackHole.originalScales.push_back(sun.scale);
-                blackHole.originalPositions.push_back(mercury.position); // Current mercury position
-                blackHole.originalScales.push_back(mercury.scale);
-                blackHole.originalPositions.push_back(venus.position); // Current venus position
-                blackHole.originalScales.push_back(venus.scale);
-                blackHole.originalPositions.push_back(earth.position); // Current earth position
-                blackHole.originalScales.push_back(earth.scale);
-                blackHole.originalPositions.push_back(moon.position); // Current moon position
-                blackHole.originalScales.push_back(moon.scale);
-                blackHole.originalPositions.push_back(mars.position); // Current mars position
-                blackHole.originalScales.push_back(mars.scale);
-                blackHole.originalPositions.push_back(jupiter.position); // Current jupiter position
-                blackHole.originalScales.push_back(jupiter.scale);
-                blackHole.originalPositions.push_back(saturn.position); // Current saturn position
-                blackHole.originalScales.push_back(saturn.scale);
-                blackHole.originalPositions.push_back(uranus.position); // Current uranus position
-                blackHole.originalScales.push_back(uranus.scale);
-                blackHole.originalPositions.push_back(neptune.position); // Current neptune position
-                blackHole.originalScales.push_back(neptune.scale);
+                for (CelestialBody *body : systemBodies)
+                {
+                    blackHole.originalPositions.push_back(body->position);
+                    blackHole.originalScales.push_back(body->scale);
+                }
 
                 wasXPressed = true;
             }
@@ -465,26 +592,11 @@ int main(int argc, char *argv[])
                 std::cout << "Black hole reset!" << std::endl;
 
                 // Reset all bodies to normal orbital positions (not the X-pressed positions)
-                sun.position = blackHole.resetPositions[0];
-                sun.scale = blackHole.resetScales[0];
-                mercury.position = blackHole.resetPositions[1];
-                mercury.scale = blackHole.resetScales[1];
-                venus.position = blackHole.resetPositions[2];
-                venus.scale = blackHole.resetScales[2];
-                earth.position = blackHole.resetPositions[3];
-                earth.scale = blackHole.resetScales[3];
-                moon.position = blackHole.resetPositions[4];
-                moon.scale = blackHole.resetScales[4];
-                mars.position = blackHole.resetPositions[5];
-                mars.scale = blackHole.resetScales[5];
-                jupiter.position = blackHole.resetPositions[6];
-                jupiter.scale = blackHole.resetScales[6];
-                saturn.position = blackHole.resetPositions[7];
-                saturn.scale = blackHole.resetScales[7];
-                uranus.position = blackHole.resetPositions[8];
-                uranus.scale = blackHole.resetScales[8];
-                neptune.position = blackHole.resetPositions[9];
-                neptune.scale = blackHole.resetScales[9];
+                for (size_t i = 0; i < systemBodies.size(); i++)
+                {
+                    systemBodies[i]->position = blackHole.resetPositions[i];
+                    systemBodies[i]->scale = blackHole.resetScales[i];
+                }
 
                 wasRPressed = true;
             }
@@ -494,7 +606,53 @@ int main(int argc, char *argv[])
             wasRPressed = false;
         }
 
-        float animationDt = isPaused ? 0.0f : dt * timeSpeed;
+        // Dynamic bodies (comets, gravity simulation) advance in adaptive substeps within the frame's compute budget.
+        // Scripted orbits are then evaluated analytically at whatever time the substeps actually reached.
+        bool gravityActive = (options.physicsMode == LaunchOptions::PhysicsMode::BarnesHut ||
+                              options.physicsMode == LaunchOptions::PhysicsMode::Direct) &&
+                             !blackHole.active && !comparisonMode;
+        if (gravityActive && !gravitySeeded)
+        {
+            // (Re)start the simulation from the scripted layout after the black hole or comparison mode
+            seedGravity();
+        }
+        const double gravityStep = 1.0 / 240.0;
+        bool wasTimeLimited = timeController.limited;
+        double simAdvance = timeController.advance(isPaused ? 0.0 : dt,
+                                                   [&](double remaining)
+                                                   {
+                                                       double h = remaining;
+                                                       for (const Comet &comet : comets)
+                                                       {
+                                                           h = std::min(h, comet.preferredStep());
+                                                       }
+                                                       if (gravityActive)
+                                                       {
+                                                           h = std::min(h, gravityStep);
+                                                       }
+                                                       return std::min(h, remaining);
+                                                   },
+                                                   [&](double h)
+                                                   {
+                                                       for (Comet &comet : comets)
+                                                       {
+                                                           comet.advance(h);
+                                                       }
+                                                       if (gravityActive && options.physicsMode == LaunchOptions::PhysicsMode::Direct)
+                                                       {
+                                                           directSummation.step(gravitySystem, h);
+                                                       }
+                                                       else if (gravityActive)
+                                                       {
+                                                           barnesHut.step(gravitySystem, h);
+                                                       }
+                                                   });
+        if (timeController.limited && !wasTimeLimited)
+        {
+            std::cout << "Time speed limited by compute budget: requested " << timeController.timeSpeed << "x, running at "
+                      << timeController.effectiveSpeed << "x" << std::endl;
+        }
+        float animationDt = float(simAdvance);
 
         // Update camera for planet selection mode
         if (planetSelectionMode)
@@ -504,49 +662,54 @@ int main(int argc, char *argv[])
         }
 
         // Clear buffers
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        depthBuffer.beginFrame();
 
         // Update view matrix
+        // View is relative to the camera position: world positions are shifted by renderOrigin before they become floats
         mat4 viewMatrix = camera.updateViewMatrix();
+        FloatingOrigin renderOrigin;
+        renderOrigin.origin = camera.position;
         GLuint viewMatrixLocation = glGetUniformLocation(shaders.base, "viewMatrix");
         glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
 
-        // Render skybox
-        skybox.render(shaders.skybox, viewMatrix, projectionMatrix);
-
         // Setup base shader for scene rendering
-        glUseProgram(shaders.base);
+        RenderState::useProgram(shaders.base);
 
         glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
 
         glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
 
-        glBindVertexArray(vao);
+        RenderState::bindVertexArray(cube.vao);
 
-        // Update and render spinning duck (third-person view only)
+        // Update and submit spinning duck (third-person view only)
         spinningCubeAngle += 180.0f * dt;
-        if (!camera.firstPerson && !planetSelectionMode)
+        if (!camera.firstPerson && !planetSelectionMode && !duckModel.meshes.empty())
         {
-            GLuint worldMatrixLocation = glGetUniformLocation(shaders.base, "worldMatrix");
-
-            mat4 spinningCubeWorldMatrix = translate(mat4(1.0f), camera.position + vec3(0.0f, -0.2f, 0.0f)) *
+            // The camera is the render origin, so the duck just sits below zero
+            mat4 spinningCubeWorldMatrix = translate(mat4(1.0f), vec3(0.0f, -0.2f, 0.0f)) *
                                            rotate(mat4(1.0f), radians(spinningCubeAngle), vec3(0.0f, 1.0f, 0.0f)) *
                                            rotate(mat4(1.0f), radians(1.0f), vec3(0.0f, 0.0f, 1.0f)) *
                                            scale(mat4(1.0f), vec3(0.0006f, 0.0006f, 0.0006f));
 
-            glUniformMatrix4fv(worldMatrixLocation, 1, GL_FALSE, &spinningCubeWorldMatrix[0][0]);
-
-            if (!duckModel.meshes.empty())
-            {
-                glDisable(GL_CULL_FACE);
-                duckModel.Draw(shaders.base);
-                glEnable(GL_CULL_FACE);
-            }
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Opaque, shaders.base, duckModel.meshes[0].texture, 0.0f),
+                               [spinningCubeWorldMatrix, &shaders, &duckModel]()
+                               {
+                                   RenderState::useProgram(shaders.base);
+                                   GLuint worldMatrixLocation = glGetUniformLocation(shaders.base, "worldMatrix");
+                                   glUniformMatrix4fv(worldMatrixLocation, 1, GL_FALSE, &spinningCubeWorldMatrix[0][0]);
+
+                                   RenderState::setCullFace(false);
+                                   RenderState::setBlend(false);
+                                   RenderState::setDepthTest(true);
+                                   duckModel.Draw(shaders.base);
+                               });
         }
 
         // Update celestial body positions and handle black hole effect
-        orbAngle += 20.0f * animationDt;
-        vec3 sunPosition = vec3(0.0f, 0.0f, -20.0f);
+        orbAngle = 20.0 * timeController.simTime;
+        bool ephemerisActive = options.physicsMode == LaunchOptions::PhysicsMode::Ephemeris && ephemeris.valid();
+        double julianDate = ephemerisStartDate + timeController.simTime * ephemerisDaysPerSecond;
+        auto parentOf = [&](uint32_t i) -> CelestialBody & { return *sceneBodies[scene.body(i).parent]; };
 
         // FIXED: Proper black hole effect implementation
         if (blackHole.active)
@@ -560,271 +723,387 @@ int main(int argc, char *argv[])
                 std::max(0.0f, 1.0f - blackHole.strength); // Goes from 1.0 to 0.0 (completely invisible)
 
             // Linear interpolation function
-            auto lerp = [](const vec3 &a, const vec3 &b, float t) -> vec3 { return a + t * (b - a); };
+            auto lerp = [](const dvec3 &a, const dvec3 &b, double t) -> dvec3 { return a + t * (b - a); };
 
             // Apply effect to ALL bodies including the sun - they all go to the black hole center
-            sun.position = lerp(blackHole.originalPositions[0], blackHole.position, blackHole.strength);
-            sun.scale = blackHole.originalScales[0] * shrinkFactor;
-
-            mercury.position = lerp(blackHole.originalPositions[1], blackHole.position, blackHole.strength);
-            mercury.scale = blackHole.originalScales[1] * shrinkFactor;
-
-            venus.position = lerp(blackHole.originalPositions[2], blackHole.position, blackHole.strength);
-            venus.scale = blackHole.originalScales[2] * shrinkFactor;
-
-            earth.position = lerp(blackHole.originalPositions[3], blackHole.position, blackHole.strength);
-            earth.scale = blackHole.originalScales[3] * shrinkFactor;
-
-            moon.position = lerp(blackHole.originalPositions[4], blackHole.position, blackHole.strength);
-            moon.scale = blackHole.originalScales[4] * shrinkFactor;
-
-            mars.position = lerp(blackHole.originalPositions[5], blackHole.position, blackHole.strength);
-            mars.scale = blackHole.originalScales[5] * shrinkFactor;
-
-            jupiter.position = lerp(blackHole.originalPositions[6], blackHole.position, blackHole.strength);
-            jupiter.scale = blackHole.originalScales[6] * shrinkFactor;
-
-            saturn.position = lerp(blackHole.originalPositions[7], blackHole.position, blackHole.strength);
-            saturn.scale = blackHole.originalScales[7] * shrinkFactor;
-
-            uranus.position = lerp(blackHole.originalPositions[8], blackHole.position, blackHole.strength);
-            uranus.scale = blackHole.originalScales[8] * shrinkFactor;
-
-            neptune.position = lerp(blackHole.originalPositions[9], blackHole.position, blackHole.strength);
-            neptune.scale = blackHole.originalScales[9] * shrinkFactor;
+            for (size_t i = 0; i < systemBodies.size(); i++)
+            {
+                systemBodies[i]->position = lerp(blackHole.originalPositions[i], blackHole.position, blackHole.strength);
+                systemBodies[i]->scale = blackHole.originalScales[i] * shrinkFactor;
+            }
 
             // Don't do normal orbital updates during black hole effect - COMPLETELY override positions
+            gravitySeeded = false;
         }
         else
         {
             // Check if we're in comparison mode
             if (comparisonMode)
             {
-                // Position planets in a straight line by size: smallest to largest
-                // Position sun slightly to the side so it doesn't block planets
-                sun.position = vec3(-15.0f, 0.0f, -20.0f);
-
-                // Line up planets by size from smallest to largest, moving away from sun
-                // Position them so sun light can reach all of them (no shadows)
-
-                float baseSpacing = 8.0f;    // Base distance between each planet
-                float saturnExtra = 4.0f;    // Extra spacing around Saturn for rings
-                float startDistance = 5.0f;   // Distance from sun position to first planet
-                
-                // Calculate positions with extra space around Saturn
-                mercury.position = vec3(startDistance, 0, -20);               // 0.11f - Smallest
-                mars.position = vec3(startDistance + baseSpacing * 1, 0, -20);    // 0.16f - Mars is smaller than Earth!
-                venus.position = vec3(startDistance + baseSpacing * 2, 0, -20);   // 0.28f
-                earth.position = vec3(startDistance + baseSpacing * 3, 0, -20);   // 0.3f
-                moon.position = vec3(startDistance + baseSpacing * 3.3f, 2, -20); // Moon near Earth
-                neptune.position = vec3(startDistance + baseSpacing * 4, 0, -20); // 1.17f - Neptune is smaller than Uranus!
-                uranus.position = vec3(startDistance + baseSpacing * 5, 0, -20);  // 1.2f
-                saturn.position = vec3(startDistance + baseSpacing * 6 + saturnExtra, 0, -20);  // 2.82f - Extra space for rings
-                jupiter.position = vec3(startDistance + baseSpacing * 7 + saturnExtra * 2.5, 0, -20); // 3.36f - Largest
+                // Bodies line up by size at the scene's comparison positions, the sun off to the side so its light
+                // reaches all of them (no shadows)
+                for (uint32_t i = 0; i < scene.bodyCount(); i++)
+                {
+                    const SceneFile::BodyRecord &record = scene.body(i);
+                    if (record.kind != SceneFile::Comet && (record.flags & SceneFile::HAS_COMPARISON))
+                    {
+                        sceneBodies[i]->position = dvec3(record.comparison[0], record.comparison[1], record.comparison[2]);
+                    }
+                }
 
                 // Still allow rotation in comparison mode
-                sun.rotationAngle += sun.rotationSpeed * animationDt;
-                mercury.rotationAngle += mercury.rotationSpeed * animationDt;
-                venus.rotationAngle += venus.rotationSpeed * animationDt;
-                earth.rotationAngle += earth.rotationSpeed * animationDt;
-                mars.rotationAngle += mars.rotationSpeed * animationDt;
-                jupiter.rotationAngle += jupiter.rotationSpeed * animationDt;
-                saturn.rotationAngle += saturn.rotationSpeed * animationDt;
-                uranus.rotationAngle += uranus.rotationSpeed * animationDt;
-                neptune.rotationAngle += neptune.rotationSpeed * animationDt;
-                moon.rotationAngle += moon.rotationSpeed * animationDt;
+                for (CelestialBody *body : systemBodies)
+                {
+                    body->spin(animationDt);
+                }
+                gravitySeeded = false;
+            }
+            else if (gravityActive)
+            {
+                // Gravity was stepped with the other dynamic bodies above
+                for (size_t i = 0; i < gravityBodies.size(); i++)
+                {
+                    gravityBodies[i]->position = gravitySystem.position(i);
+                    gravityBodies[i]->spin(animationDt);
+                }
+                // Planets without a mass keep their scripted orbits
+                for (uint32_t i : planetIndices)
+                {
+                    if (!inGravity[i])
+                    {
+                        sceneBodies[i]->update(parentOf(i).position, orbAngle, animationDt);
+                    }
+                }
+            }
+            else
+            {
+                // Scripted circles, or real positions for bodies the ephemeris covers; the sun only spins
+                for (CelestialBody *body : rootBodies)
+                {
+                    body->spin(animationDt);
+                }
+                for (uint32_t i : planetIndices)
+                {
+                    CelestialBody *body = sceneBodies[i];
+                    int ephemerisBody = scene.body(i).ephemeris;
+                    if (ephemerisActive && ephemerisBody >= 0)
+                    {
+                        dvec3 heliocentric = ephemeris.position(KeplerianElements::Body(ephemerisBody), julianDate);
+                        body->position = parentOf(i).position + orbitScale.toScene(heliocentric);
+                        body->spin(animationDt);
+                    }
+                    else
+                    {
+                        body->update(parentOf(i).position, orbAngle, animationDt);
+                    }
+                }
+            }
+        }
+
+        // Moons orbit their planet in its local frame, unless the black hole or comparison mode placed them in the world
+        for (uint32_t i : satelliteIndices)
+        {
+            CelestialBody *body = sceneBodies[i];
+            int ephemerisBody = scene.body(i).ephemeris;
+            if (blackHole.active || comparisonMode)
+            {
+                satelliteOffsets[i] = body->position - parentOf(i).position;
+                continue;
+            }
+            if (ephemerisActive && ephemerisBody >= 0)
+            {
+                // The Moon keeps its scene distance from Earth, only its direction comes from the ephemeris
+                dvec3 direction = orbitScale.toScene(ephemeris.position(KeplerianElements::Body(ephemerisBody), julianDate));
+                satelliteOffsets[i] = normalize(direction) * double(body->orbitRadius);
             }
             else
             {
-                // Normal celestial body updates only when black hole is not active
-                sun.update(sun.position, orbAngle, animationDt);
-                mercury.update(sun.position, orbAngle, animationDt);
-                venus.update(sun.position, orbAngle, animationDt);
-                earth.update(sun.position, orbAngle, animationDt);
-                mars.update(sun.position, orbAngle, animationDt);
-                jupiter.update(sun.position, orbAngle, animationDt);
-                saturn.update(sun.position, orbAngle, animationDt);
-                uranus.update(sun.position, orbAngle, animationDt);
-                neptune.update(sun.position, orbAngle, animationDt);
-                moon.update(earth.position, orbAngle, animationDt);
+                satelliteOffsets[i] = body->orbitOffset(orbAngle);
             }
+            body->spin(animationDt);
         }
+
         // Update comets
-		halleysComet.update(animationDt, sun.position);
-        comet2.update(animationDt, sun.position);
+        for (Comet &comet : comets)
+        {
+            comet.update(animationDt, sun.position);
+        }
+
+        // Push this frame's local transforms into the hierarchy; only nodes that changed get recomputed
+        for (uint32_t i = 0; i < scene.bodyCount(); i++)
+        {
+            const CelestialBody &body = *sceneBodies[i];
+            int parent = scene.body(i).parent;
+            dvec3 localPosition = body.position;
+            if (parent >= 0)
+            {
+                localPosition = scene.body(parent).parent >= 0 ? satelliteOffsets[i] : body.position - parentOf(i).position;
+            }
+            transforms.setTranslation(body.transformNode, localPosition);
+            transforms.setRotation(body.transformNode, body.rotationAngle, 180.0f);
+            transforms.setScale(body.transformNode, body.scale);
+        }
+        transforms.update();
+        for (uint32_t i : satelliteIndices)
+        {
+            sceneBodies[i]->position = transforms.worldPosition(sceneBodies[i]->transformNode);
+        }
+
+        // Collect all planet positions and radii for shadow calculations (uploaded once per frame, in render space)
+        vector<vec4> shadowCasters;
 
-        // Collect all planet positions and radii for shadow calculations
-        vector<vec3> planetPositions;
-        vector<float> planetRadii;
-        
         if (!comparisonMode) {
-            planetPositions = {
-                mercury.position,
-                venus.position,
-                earth.position,
-                mars.position,
-                jupiter.position,
-                saturn.position,
-                uranus.position,
-                neptune.position,
-                moon.position
-            };
-            planetRadii = {
-                mercury.scale.x,
-                venus.scale.x,
-                earth.scale.x,
-                mars.scale.x,
-                jupiter.scale.x,
-                saturn.scale.x,
-                uranus.scale.x,
-                neptune.scale.x,
-                moon.scale.x
+            auto caster = [&renderOrigin](const CelestialBody &body)
+            {
+                return vec4(renderOrigin.toRender(body.position), body.scale.x);
             };
+            for (const CelestialBody *body : orbitingBodies)
+            {
+                shadowCasters.push_back(caster(*body));
+            }
         }
+        sceneBuffer.update(shadowCasters);
 
-        // Render all celestial bodies in order from sun outward - BUT ONLY IF VISIBLE
+        // Submit all celestial bodies to the render queue - BUT ONLY IF VISIBLE
         // Check if each body is large enough to be visible (scale > 0.01f means visible)
+        // Opaque bodies are sorted front-to-back, rings and trails back-to-front, so declaration order no longer matters
+        dvec3 eyePosition = camera.eyePosition();
+        vec3 renderEye = renderOrigin.toRender(eyePosition);
+        vec3 renderSun = renderOrigin.toRender(sun.position);
+        bool useImpostors = options.bodyMode == LaunchOptions::BodyMode::Impostor;
+        ShaderVariants &bodyVariants = useImpostors ? shaders.bodyImpostors : shaders.bodies;
+        bodyPoints.clear();
+        auto submitBody = [&](const CelestialBody &body, bool isSun)
+        {
+            // Sub-pixel bodies cost one vertex in the shared point batch instead of a full sphere
+            if (!isSun && bodyPoints.add(body, sun.position, eyePosition, renderOrigin, projectionMatrix))
+            {
+                return;
+            }
+            // The permutation decides sun, shadows and atmosphere, so the fragment shader does not branch on them
+            uint32_t features = ShaderCache::SUN;
+            if (!isSun)
+            {
+                features = (shadowCasters.empty() ? 0u : uint32_t(ShaderCache::SHADOWS)) |
+                           (body.atmosphere ? uint32_t(ShaderCache::ATMOSPHERE) : 0u);
+            }
+            GLuint bodyShader = bodyVariants.get(features);
+            float viewDistance = std::max(0.0f, float(length(body.position - eyePosition)) - body.scale.x);
+            mat4 worldMatrix = transforms.renderMatrix(body.transformNode, renderOrigin);
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Opaque, bodyShader, body.texture, viewDistance),
+                               [&body, useImpostors, bodyShader, &viewMatrix, &projectionMatrix, worldMatrix, renderSun,
+                                renderEye]()
+                               {
+                                   if (useImpostors)
+                                   {
+                                       body.renderImpostor(bodyShader,
+                                                           viewMatrix,
+                                                           projectionMatrix,
+                                                           worldMatrix,
+                                                           renderSun,
+                                                           renderEye);
+                                   }
+                                   else
+                                   {
+                                       body.render(bodyShader,
+                                                   viewMatrix,
+                                                   projectionMatrix,
+                                                   worldMatrix,
+                                                   renderSun,
+                                                   renderEye);
+                                   }
+                               });
+        };
+
+        for (CelestialBody *star : rootBodies)
+        {
+            if (star->scale.x > 0.01f)
+            {
+                submitBody(*star, true);
+            }
+        }
+        for (CelestialBody *planet : orbitingBodies)
+        {
+            if (planet->scale.x > 0.01f)
+            {
+                submitBody(*planet, false);
+            }
+        }
+        for (const Comet &comet : comets)
+        {
+            submitBody(comet.body, false);
+        }
+
+        // Whole belt in one instanced draw, hidden while the planets are lined up for comparison
+        if (catalogBelt)
+        {
+            smallBodies.stream(asteroidBelt, 65536);
+        }
+        if (!comparisonMode && asteroidBelt.count > 0)
+        {
+            // Clock wrapped every 1000 Earth orbits so the float uniform keeps its precision. With the ephemeris,
+            // catalog orbits follow the date: one Earth orbit per Julian year from J2000, their element epoch.
+            double beltAngle = orbAngle;
+            if (catalogBelt && ephemerisActive)
+            {
+                beltAngle = (julianDate - KeplerianElements::J2000) * 360.0 / 365.25;
+            }
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Opaque, shaders.asteroids, 0, 0.0f),
+                               [&, beltAngle]()
+                               {
+                                   float collapse = blackHole.active ? blackHole.strength : 0.0f;
+                                   beltTimer.begin();
+                                   asteroidBelt.render(shaders.asteroids,
+                                                       viewMatrix,
+                                                       projectionMatrix,
+                                                       renderSun,
+                                                       float(radians(fmod(beltAngle, 360000.0))),
+                                                       collapse,
+                                                       renderOrigin.toRender(blackHole.position));
+                                   beltTimer.end();
+                               });
+        }
+
+        // Sky fills only the pixels no opaque body covered
+        renderQueue.submit(renderQueue.makeKey(RenderQueue::Sky, shaders.skybox, skybox.texture, 0.0f),
+                           [&]()
+                           {
+                               if (options.skyMode == LaunchOptions::SkyMode::Starfield)
+                               {
+                                   starfield.render(shaders.starfield, viewMatrix, projectionMatrix);
+                               }
+                               else
+                               {
+                                   skybox.render(shaders.skybox, viewMatrix, projectionMatrix);
+                               }
+                           });
+
+        // Point-sized bodies blend additively behind every other transparent draw
+        renderQueue.submit(renderQueue.makeKey(RenderQueue::Transparent, shaders.bodyPoints, 0, renderQueue.farDistance),
+                           [&]()
+                           {
+                               bodyPoints.render(shaders.bodyPoints, viewMatrix, projectionMatrix);
+                           });
+
+        // Rings (Saturn's) are transparent, only drawn if their planet is visible
+        for (size_t i = 0; i < rings.size(); i++)
+        {
+            const CelestialBody &planet = *sceneBodies[ringOwners[i]];
+            if (planet.scale.x <= 0.01f)
+            {
+                continue;
+            }
+            float ringDistance = float(length(planet.position - eyePosition));
+            mat4 ringMatrix = transforms.renderMatrix(ringNodes[i], renderOrigin);
+            const PlanetRing *ring = &rings[i];
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Transparent, shaders.orb, ring->texture, ringDistance),
+                               [&, ring, ringMatrix]()
+                               {
+                                   ring->render(shaders.orb, viewMatrix, projectionMatrix, ringMatrix, renderSun, renderEye);
+                               });
+        }
 
-        if (sun.scale.x > 0.01f)
-        {
-            sun.render(shaders.orb, viewMatrix, projectionMatrix, sun.position, camera.position, true);
-        }
-        if (mercury.scale.x > 0.01f)
-        {
-            mercury.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (venus.scale.x > 0.01f)
-        {
-            venus.render(shaders.orb,
-                        viewMatrix,
-                        projectionMatrix,
-                        sun.position,
-                        camera.position,
-                        false,
-                        planetPositions,
-                        planetRadii);
-        }
-        if (earth.scale.x > 0.01f)
-        {
-            earth.render(shaders.orb,
-                        viewMatrix,
-                        projectionMatrix,
-                        sun.position,
-                        camera.position,
-                        false,
-                        planetPositions,
-                        planetRadii);
-        }
-        if (mars.scale.x > 0.01f)
-        {
-            mars.render(shaders.orb,
-                       viewMatrix,
-                       projectionMatrix,
-                       sun.position,
-                       camera.position,
-                       false,
-                       planetPositions,
-                       planetRadii);
-        }
-        if (jupiter.scale.x > 0.01f)
-        {
-            jupiter.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (saturn.scale.x > 0.01f)
-        {
-            saturn.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        // Render Saturn's rings immediately after Saturn only if Saturn is visible
-        if (saturn.scale.x > 0.01f) {
-            saturnRings.render(saturn, shaders.orb, viewMatrix, projectionMatrix, sun.position, camera.position);
-        }
-        if (uranus.scale.x > 0.01f)
-        {
-            uranus.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (neptune.scale.x > 0.01f)
-        {
-            neptune.render(shaders.orb,
-                          viewMatrix,
-                          projectionMatrix,
-                          sun.position,
-                          camera.position,
-                          false,
-                          planetPositions,
-                          planetRadii);
-        }
-        if (moon.scale.x > 0.01f)
-        {
-            moon.render(shaders.orb,
-                       viewMatrix,
-                       projectionMatrix,
-                       sun.position,
-                       camera.position,
-                       false,
-                       planetPositions,
-                       planetRadii);
-        }
-
-        // Render comet trails first (so they appear behind comet heads)
-        halleysComet.renderTrail(shaders.base, viewMatrix, projectionMatrix);
-        
-        comet2.renderTrail(shaders.base, viewMatrix, projectionMatrix);        // Render comet heads
-        halleysComet.body.render(shaders.orb,
-                                  viewMatrix,
-                                  projectionMatrix,
-                                  sun.position,
-                                  camera.position,
-                                  false,
-                                  planetPositions,
-                                  planetRadii);
-        comet2.body.render(shaders.orb,
-                          viewMatrix,
-                          projectionMatrix,
-                          sun.position,
-                          camera.position,
-                          false,
-                          planetPositions,
-                          planetRadii);
+        // Comet trails blend over whatever is behind them
+        for (const Comet &comet : comets)
+        {
+            float trailDistance = float(length(comet.body.position - eyePosition));
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Transparent, shaders.base, 0, trailDistance),
+                               [&comet, &shaders, &viewMatrix, &projectionMatrix, &renderOrigin]()
+                               {
+                                   comet.renderTrail(shaders.base, viewMatrix, projectionMatrix, renderOrigin);
+                               });
+        }
 
         // Render selection indicator if in planet selection mode
         if (planetSelectionMode)
         {
-            CelestialBody *selectedBody = planetSelector.getSelectedBody();
-            planetSelector.renderSelectionIndicator(shaders.selection, viewMatrix, projectionMatrix);
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Overlay, shaders.selection, 0, 0.0f),
+                               [&]()
+                               {
+                                   planetSelector.renderSelectionIndicator(shaders.selection, viewMatrix, projectionMatrix, renderOrigin);
+                               });
         }
 
         // Render info panel if visible
         if (planetSelectionMode && infoPanel.visible)
         {
-            infoPanel.renderOnScreen(shaders.ui, 800, 600);
+            renderQueue.submit(renderQueue.makeKey(RenderQueue::Overlay, shaders.ui, 0, 0.0f),
+                               [&]()
+                               {
+                                   infoPanel.renderOnScreen(shaders.ui, 800, 600);
+                               });
+        }
+
+        // Draw everything in sorted order
+        renderQueue.flush();
+
+        // Reversed-Z draws offscreen, copy the frame to the window
+        depthBuffer.endFrame();
+
+        // Fence this frame's scene data before moving to the next slice
+        sceneBuffer.endFrame();
+
+        // Report redundant state changes avoided this frame with P
+        RenderState::Counters stateCounters = RenderState::endFrame();
+        if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS)
+        {
+            if (!wasPPressed)
+            {
+                std::cout << "Render state: " << stateCounters.issued << " changes issued, " << stateCounters.skipped
+                          << " redundant changes skipped this frame" << std::endl;
+                std::cout << "Sub-pixel bodies drawn as points: " << bodyPoints.points.size() << std::endl;
+                MemoryBudget::report(std::cout);
+                std::cout << "Asteroids: " << asteroidBelt.count << " in one instanced draw";
+                if (beltTimer.milliseconds >= 0.0)
+                {
+                    std::cout << ", " << beltTimer.milliseconds << " ms on the GPU";
+                }
+                std::cout << " (frame " << dt * 1000.0f << " ms)" << std::endl;
+                if (catalogBelt)
+                {
+                    std::cout << "Small-body catalog: "
+                              << (smallBodies.loading() ? "parsing in the background"
+                                                        : std::to_string(smallBodies.streamed) + " of " +
+                                                              std::to_string(smallBodies.count()) + " uploaded")
+                              << std::endl;
+                }
+                std::cout << "Time: requested " << timeController.timeSpeed << "x, running at " << timeController.effectiveSpeed
+                          << "x, " << timeController.lastSubsteps << " substeps"
+                          << (timeController.limited ? " (compute budget reached)" : "") << std::endl;
+                if (options.physicsMode == LaunchOptions::PhysicsMode::Ephemeris && ephemeris.valid())
+                {
+                    double julianDate = ephemerisStartDate + timeController.simTime * ephemerisDaysPerSecond;
+                    std::cout << "Ephemeris date: " << Ephemeris::calendarDate(julianDate) << " (JD " << std::fixed
+                              << julianDate << std::defaultfloat << ")"
+                              << (julianDate < ephemeris.startJulianDate || julianDate > ephemeris.endJulianDate
+                                      ? ", outside the cached range, clamped"
+                                      : "")
+                              << std::endl;
+                }
+                if (options.physicsMode != LaunchOptions::PhysicsMode::Scripted && gravitySeeded)
+                {
+                    double drift = (gravitySystem.totalEnergy() - initialEnergy) / std::abs(initialEnergy);
+                    if (options.physicsMode == LaunchOptions::PhysicsMode::Direct)
+                    {
+                        std::cout << "Gravity (direct, " << DirectSummation::kernelName() << " kernel, Yoshida 4): "
+                                  << gravitySystem.size() << " bodies, "
+                                  << directSummation.lastStats.interactionsPerSecond << " interactions/s, energy drift "
+                                  << drift << std::endl;
+                    }
+                    else
+                    {
+                        std::cout << "Gravity (Barnes-Hut, theta " << barnesHut.theta << "): " << gravitySystem.size()
+                                  << " bodies, tree " << barnesHut.lastStats.buildSeconds * 1e6 << " us, forces "
+                                  << barnesHut.lastStats.forceSeconds * 1e6 << " us per step, energy drift " << drift
+                                  << std::endl;
+                    }
+                }
+                wasPPressed = true;
+            }
+        }
+        else
+        {
+            wasPPressed = false;
         }
 
         // Swap buffers and poll events
@@ -889,7 +1168,10 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Cleanup
+    // Cleanup, waits for a catalog still being parsed
+    smallBodies.close();
+    AssetPack::unmount();
+    markGlContextDestroyed(); // GL objects still owned by locals go away with the context
     glfwTerminate();
     return 0;
 }
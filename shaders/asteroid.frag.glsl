@@ -0,0 +1,27 @@
+#version 330 core
+in vec3 Normal;
+in vec3 FragPos;
+flat in vec3 RockColor;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+uniform vec3 sunPosition;
+
+void main() {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    vec3 normal = normalize(Normal);
+    vec3 lightDir = normalize(sunPosition - FragPos);
+
+    // Same day/night split as the planets: diffuse sunlight plus a dim ambient
+    float diff = max(dot(normal, lightDir), 0.0);
+    float ambient = 0.08;
+    FragColor = vec4((ambient + diff) * RockColor, 1.0);
+}
@@ -0,0 +1,128 @@
+#version 330 core
+// Asteroid belt: orbit evaluated per vertex from static elements, no per-frame CPU work
+layout (location = 0) in vec4 aOrbit;        // Semi-major axis, eccentricity, inclination, ascending node
+layout (location = 1) in vec4 aOrientation;  // Argument of periapsis, mean anomaly at t = 0, size, spin phase
+
+#define ROCK_VARIANTS 4
+#define ROCK_VERTICES 12
+#define MAX_DISTANCE_KNOTS 16
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 rockVertices[ROCK_VARIANTS * ROCK_VERTICES];
+uniform vec3 sunPosition;
+uniform float orbitAngle;       // Simulation clock: Earth's orbital angle in radians
+uniform float referenceRadius;  // Earth's orbit radius, moves one radian per radian of orbitAngle
+uniform float collapse;         // Black hole effect, 0 = off, 1 = fully collapsed
+uniform vec3 collapseCenter;
+uniform vec2 distanceKnots[MAX_DISTANCE_KNOTS]; // Catalog belts: (AU, scene units), like OrbitScale
+uniform int distanceKnotCount;                  // 0 when the elements are already in scene units
+
+out vec3 Normal;
+out vec3 FragPos;
+flat out vec3 RockColor;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+// Icosahedron faces, expanded per vertex so each triangle gets a flat normal
+const int ROCK_INDICES[60] = int[60](
+    0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+    1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+    3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+    4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1);
+
+// Newton iterations on E - e sin E = M, converges in a few steps for belt eccentricities.
+// Comet-like orbits start from E = pi, which converges for any e < 1, and take more steps.
+float solveKepler(float meanAnomaly, float e) {
+    bool eccentric = e > 0.6;
+    float E = eccentric ? 3.14159265 : meanAnomaly + e * sin(meanAnomaly);
+    int iterations = eccentric ? 12 : 4;
+    for (int i = 0; i < iterations; i++) {
+        E -= (E - e * sin(E) - meanAnomaly) / (1.0 - e * cos(E));
+    }
+    return E;
+}
+
+// Piecewise linear AU -> scene distance, same as OrbitScale::sceneDistance
+float sceneDistance(float au) {
+    // Through the origin below the first knot, the last slope beyond the final one
+    vec2 previous = vec2(0.0);
+    for (int i = 0; i < distanceKnotCount; i++) {
+        vec2 knot = distanceKnots[i];
+        if (au <= knot.x || i + 1 == distanceKnotCount) {
+            return previous.y + (au - previous.x) * (knot.y - previous.y) / (knot.x - previous.x);
+        }
+        previous = knot;
+    }
+    return au;
+}
+
+void main() {
+    float a = aOrbit.x;
+    float e = aOrbit.y;
+    float inclination = aOrbit.z;
+    float node = aOrbit.w;
+    float periapsis = aOrientation.x;
+
+    // Kepler's third law relative to Earth: mean motion ~ a^-1.5
+    float meanMotion = pow(referenceRadius / a, 1.5);
+    float meanAnomaly = mod(aOrientation.y + orbitAngle * meanMotion, 6.28318531);
+    float E = solveKepler(meanAnomaly, e);
+
+    // Position in the orbital plane, sun at the focus
+    float x = a * (cos(E) - e);
+    float y = a * sqrt(1.0 - e * e) * sin(E);
+
+    // Rotate by periapsis, inclination and node into the reference plane
+    float cw = cos(periapsis), sw = sin(periapsis);
+    float ci = cos(inclination), si = sin(inclination);
+    float cn = cos(node), sn = sin(node);
+    vec3 orbital = vec3((cn * cw - sn * sw * ci) * x + (-cn * sw - sn * cw * ci) * y,
+                        (sw * si) * x + (cw * si) * y,
+                        (sn * cw + cn * sw * ci) * x + (-sn * sw + cn * cw * ci) * y);
+    // Reference plane is XZ and motion runs from +X toward +Z, same as CelestialBody::update
+
+    // Catalog elements are heliocentric ecliptic in AU: compress the distance and use the ephemeris frame,
+    // where ecliptic (x, y, z) is world (x, z, -y)
+    if (distanceKnotCount > 0) {
+        float r = length(orbital);
+        orbital *= sceneDistance(r) / max(r, 1e-6);
+        orbital.z = -orbital.z;
+    }
+
+    vec3 center = mix(sunPosition + orbital, collapseCenter, collapse);
+    float size = aOrientation.z * (1.0 - collapse);
+
+    // Rock shape and tumble
+    int base = (gl_InstanceID % ROCK_VARIANTS) * ROCK_VERTICES;
+    int triangle = gl_VertexID / 3 * 3;
+    vec3 v0 = rockVertices[base + ROCK_INDICES[triangle]];
+    vec3 v1 = rockVertices[base + ROCK_INDICES[triangle + 1]];
+    vec3 v2 = rockVertices[base + ROCK_INDICES[triangle + 2]];
+    vec3 corner = rockVertices[base + ROCK_INDICES[gl_VertexID]];
+
+    vec3 faceNormal = normalize(cross(v1 - v0, v2 - v0));
+    if (dot(faceNormal, v0 + v1 + v2) < 0.0) {
+        faceNormal = -faceNormal;
+    }
+
+    float spin = aOrientation.w + orbitAngle * 6.0;
+    float cs = cos(spin), ss = sin(spin);
+    mat3 tumble = mat3(cs, 0.0, -ss,
+                       0.0, 1.0, 0.0,
+                       ss, 0.0, cs);
+
+    Normal = tumble * faceNormal;
+    FragPos = center + tumble * corner * size;
+
+    // Grey to brown, seeded by the random spin phase
+    float tint = fract(aOrientation.w * 7.31);
+    RockColor = mix(vec3(0.42, 0.40, 0.38), vec3(0.55, 0.44, 0.33), tint);
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(FragPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
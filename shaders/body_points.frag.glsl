@@ -0,0 +1,23 @@
+#version 330 core
+in vec3 PointColor;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+void main() {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    // Round sprite with a soft gaussian core
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(d, d);
+    if (r2 > 1.0) {
+        discard;
+    }
+    FragColor = vec4(PointColor * exp(-4.0 * r2), 1.0);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+layout (location = 0) in vec3 aPosition;  // Body center relative to the camera (floating origin)
+layout (location = 1) in vec3 aColor;     // Body hue, brightest channel = 1
+layout (location = 2) in float aLogFlux;  // ln of reflected light, 0 = a lit 1 pixel body at Earth's distance
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 PointColor;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+void main() {
+    // Same logarithmic compression as the starfield so dim bodies fade out instead of vanishing
+    float brightness = clamp(1.0 + aLogFlux * 0.15, 0.15, 1.0);
+    PointColor = aColor * brightness;
+    gl_PointSize = clamp(2.0 + aLogFlux * 0.3, 1.0, 2.5);
+
+    gl_Position = projection * view * vec4(aPosition, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
@@ -0,0 +1,102 @@
+// Surface lighting shared by the mesh and impostor body shaders, included after their inputs.
+// Compiled per ShaderCache feature set instead of branching on uniforms per fragment:
+// SUN         self-lit with a warm rim glow, no sunlight or shadows
+// SHADOWS     other bodies in SceneData block the sunlight (off in comparison mode)
+// ATMOSPHERE  rim glow tinted by the surface colors (off for bodies marked 'airless' in the scene)
+uniform vec3 lightPos;      // Sun's position
+uniform vec3 viewPos;       // Camera position
+
+#ifdef SHADOWS
+// Shadow casters, uploaded once per frame by SceneBuffer
+// 1023 bodies + header fills the 16 KB minimum uniform block size
+#define MAX_SCENE_BODIES 1023
+layout(std140) uniform SceneData {
+    int bodyCount;                      // Number of shadow casters
+    vec4 bodies[MAX_SCENE_BODIES];      // xyz = position, w = radius
+};
+
+bool isInShadow(vec3 fragPos) {
+    vec3 lightDir = normalize(lightPos - fragPos);
+    float distanceToLight = length(lightPos - fragPos);
+
+    // Check each planet for potential shadowing
+    for (int i = 0; i < bodyCount; i++) {
+        vec3 planetPosition = bodies[i].xyz;
+        vec3 planetToFragment = fragPos - planetPosition;
+        float planetRadius = bodies[i].w;
+
+        // Skip if this is our own planet
+        if (length(planetToFragment) < planetRadius * 1.1) continue;
+
+        // Calculate closest point on ray to planet center
+        float t = dot(lightDir, planetPosition - fragPos);
+        vec3 closestPoint = fragPos + lightDir * t;
+
+        // Check if closest point is between fragment and light
+        if (t > 0 && t < distanceToLight) {
+            float dist = length(closestPoint - planetPosition);
+            if (dist < planetRadius) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#endif
+
+#ifdef ATMOSPHERE
+// Planet type guessed from the dominant surface colors
+vec3 getAtmosphereColor(vec4 texColor) {
+    // Earth - blue atmosphere
+    if (texColor.b > 0.3 && texColor.g > 0.3) {
+        return vec3(0.3, 0.6, 1.0); // Light blue
+    }
+    // Mars - thin reddish atmosphere
+    else if (texColor.r > texColor.g && texColor.r > texColor.b) {
+        return vec3(1.0, 0.4, 0.2); // Orange-red
+    }
+    // Venus - thick yellowish atmosphere
+    else if (texColor.r > 0.6 && texColor.g > 0.6 && texColor.b < 0.3) {
+        return vec3(1.0, 0.8, 0.3); // Yellow-orange
+    }
+    // Gas giants - use dominant color with slight blue tint
+    else {
+        return mix(texColor.rgb, vec3(0.5, 0.7, 1.0), 0.3);
+    }
+}
+#endif
+
+// Lit color of a surface point; fragPos and normal in world axes relative to the camera
+vec4 shadeBody(vec4 texColor, vec3 fragPos, vec3 normal) {
+    normal = normalize(normal);
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+#ifdef SUN
+    // Sun is self-illuminating with slight glow
+    float rim = pow(1.0 - max(dot(normal, viewDir), 0.0), 2.0);
+    vec3 glowColor = vec3(1.0, 0.8, 0.4); // Warm sun glow
+    return texColor + vec4(glowColor * rim * 0.3, 0.0);
+#else
+    // Calculate diffuse lighting (day/night effect)
+    vec3 lightDir = normalize(lightPos - fragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+#ifdef SHADOWS
+    if (isInShadow(fragPos)) {
+        diff *= 0.1; // Reduce lighting significantly in shadowed areas
+    }
+#endif
+
+    // Ambient light (for slightly visible night side)
+    float ambientStrength = 0.1;
+    vec3 ambient = ambientStrength * vec3(1.0);
+    vec3 result = (ambient + diff) * texColor.rgb;
+
+#ifdef ATMOSPHERE
+    // Atmospheric rim lighting, stronger on the lit side
+    float rim = pow(1.0 - max(dot(normal, viewDir), 0.0), 3.0);
+    float glowStrength = 0.4 * (0.5 + 0.5 * diff);
+    result += getAtmosphereColor(texColor) * rim * glowStrength;
+#endif
+    return vec4(result, texColor.a);
+#endif
+}
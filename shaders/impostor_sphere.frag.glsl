@@ -0,0 +1,62 @@
+#version 330 core
+// Ray-traced sphere impostor: intersects the view ray with the body per pixel,
+// writes the true depth and derives normal and UV analytically (matches SphereUtils' UV layout)
+in vec3 ViewRay;
+flat in vec3 CenterView;
+
+out vec4 FragColor;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 center;        // Sphere center relative to the camera (floating origin)
+uniform float radius;       // Sphere radius
+uniform mat3 bodyRotation;  // Spin and flip from CelestialBody::getWorldMatrix, without scale
+
+uniform sampler2D texture1;
+
+#ifdef LOG_DEPTH
+uniform float logDepthCoefficient;
+#endif
+
+#include "body_shading.glsl"
+
+void main() {
+    // Ray from the eye (view-space origin) against the sphere
+    vec3 rayDir = normalize(ViewRay);
+    float b = dot(rayDir, CenterView);
+    float h = b * b - dot(CenterView, CenterView) + radius * radius;
+    if (h < 0.0) {
+        discard;
+    }
+    vec3 hitView = rayDir * (b - sqrt(h));
+
+    // True depth of the hit point instead of the quad's, in whichever depth mode is active
+    vec4 clipPos = projectionMatrix * vec4(hitView, 1.0);
+#if defined(LOG_DEPTH)
+    gl_FragDepth = log2(1.0 + clipPos.w) * logDepthCoefficient;
+#elif defined(REVERSED_Z)
+    gl_FragDepth = clipPos.z / clipPos.w; // glClipControl zero-to-one: NDC z is already window depth
+#else
+    gl_FragDepth = (clipPos.z / clipPos.w) * 0.5 + 0.5;
+#endif
+
+    // Back to world space: the inverse of the view rotation is its transpose
+    vec3 normal = transpose(mat3(viewMatrix)) * ((hitView - CenterView) / radius);
+    vec3 fragPos = center + normal * radius;
+
+    // Object-space direction gives the same UVs as the UV sphere mesh
+    vec3 objectDir = transpose(bodyRotation) * normal;
+    float u = atan(objectDir.z, objectDir.x) / 6.28318531;
+    float uWrapped = fract(u);          // Seam at u = 0
+    float uCentered = fract(u + 0.5);   // Seam at u = 0.5
+    float v = asin(clamp(objectDir.y, -1.0, 1.0)) / 3.14159265 + 0.5;
+    vec2 texCoord = vec2(uWrapped, v);
+
+    // Take derivatives from whichever parameterization has no seam here, so mip selection stays smooth
+    float dudx = abs(dFdx(uWrapped)) < abs(dFdx(uCentered)) ? dFdx(uWrapped) : dFdx(uCentered);
+    float dudy = abs(dFdy(uWrapped)) < abs(dFdy(uCentered)) ? dFdy(uWrapped) : dFdy(uCentered);
+    vec2 texCoordDx = vec2(dudx, dFdx(v));
+    vec2 texCoordDy = vec2(dudy, dFdy(v));
+
+    FragColor = shadeBody(textureGrad(texture1, texCoord, texCoordDx, texCoordDy), fragPos, normal);
+}
@@ -0,0 +1,33 @@
+#version 330 core
+// Camera-facing quad that covers a sphere's silhouette; the fragment shader ray-traces the sphere.
+// Drawn as a 4-vertex triangle strip with no vertex attributes.
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 center;   // Sphere center relative to the camera (floating origin)
+uniform float radius;  // Sphere radius
+
+out vec3 ViewRay;          // View-space point on the quad, i.e. the ray from the eye through this pixel
+flat out vec3 CenterView;  // Sphere center in view space
+
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1) * 2.0 - 1.0;
+
+    CenterView = (viewMatrix * vec4(center, 1.0)).xyz;
+    float distanceToCenter = length(CenterView);
+    vec3 axis = CenterView / distanceToCenter;
+
+    // Quad through the center, perpendicular to the view axis
+    vec3 helper = abs(axis.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    vec3 right = normalize(cross(axis, helper));
+    vec3 up = cross(right, axis);
+
+    // The silhouette cone has half-angle asin(r / d), its cross-section at the center is r * d / sqrt(d^2 - r^2)
+    float halfSize = radius * 10.0;
+    if (distanceToCenter > radius * 1.01) {
+        halfSize = radius * distanceToCenter / sqrt(distanceToCenter * distanceToCenter - radius * radius);
+    }
+
+    ViewRay = CenterView + (right * corner.x + up * corner.y) * halfSize;
+    gl_Position = projectionMatrix * vec4(ViewRay, 1.0);
+}
@@ -1,9 +1,18 @@
 #version 330 core
 out vec4 FragColor;
 
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
 uniform vec3 selectionColor;
 
 void main()
 {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
     FragColor = vec4(selectionColor, 1.0);
 }
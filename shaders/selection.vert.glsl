@@ -7,7 +7,14 @@ uniform mat4 worldMatrix;
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
 
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
 void main()
 {
     gl_Position = projectionMatrix * viewMatrix * worldMatrix * vec4(aPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
 }
@@ -4,13 +4,22 @@ in vec2 TexCoords;
 
 out vec4 FragColor;
 
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
 uniform sampler2D texture1;
-uniform vec3 lightPos;  // Light position in world space
+uniform vec3 lightPos;  // Light position relative to the camera (floating origin)
 uniform vec3 viewPos;   // Camera position
 uniform vec3 selectionColor;  // Selection indicator color
 
 void main()
 {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
     // If selection color is provided, use it directly (for selection indicator)
     if (selectionColor != vec3(0.0)) {
         FragColor = vec4(selectionColor, 1.0);
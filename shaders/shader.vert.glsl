@@ -10,9 +10,16 @@ uniform mat4 projectionMatrix = mat4(1.0);
 out vec3 Normal;
 out vec2 TexCoords;
 
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
 void main()
 {
     Normal = mat3(transpose(inverse(worldMatrix))) * aNormal;
     TexCoords = aTexCoords;
     gl_Position = projectionMatrix * viewMatrix * worldMatrix * vec4(aPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
 }
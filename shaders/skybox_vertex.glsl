@@ -1,14 +1,21 @@
 #version 330 core
-layout(location = 0) in vec3 aPos;
-
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+uniform mat4 inverseViewProjection;
 
 void main()
 {
-    TexCoords = aPos;
-    vec4 pos = projection * view * vec4(aPos, 1.0);
-    gl_Position = pos.xyww;
+    // Full-screen triangle from the vertex index: (-1,-1), (3,-1), (-1,3)
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+
+    // View ray through this corner of the far plane (affine across the screen, so interpolation is exact)
+    vec4 ray = inverseViewProjection * vec4(pos, 1.0, 1.0);
+    TexCoords = ray.xyz / ray.w;
+
+    // z = w puts the sky at depth 1.0, same as the old pos.xyww trick (reversed-Z: far is depth 0.0)
+#ifdef REVERSED_Z
+    gl_Position = vec4(pos, 0.0, 1.0);
+#else
+    gl_Position = vec4(pos, 1.0, 1.0);
+#endif
 }
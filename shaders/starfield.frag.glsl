@@ -0,0 +1,14 @@
+#version 330 core
+in vec3 StarColor;
+
+out vec4 FragColor;
+
+void main() {
+    // Round sprite with a soft gaussian core
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(d, d);
+    if (r2 > 1.0) {
+        discard;
+    }
+    FragColor = vec4(StarColor * exp(-4.0 * r2), 1.0);
+}
@@ -0,0 +1,39 @@
+#version 330 core
+layout (location = 0) in vec3 aDirection;   // Unit vector toward the star
+layout (location = 1) in float aMagnitude;  // (mag + 2) * 20
+layout (location = 2) in float aColorIndex; // (B-V + 0.5) * 100
+
+uniform mat4 view;        // Rotation only
+uniform mat4 projection;
+uniform float pointScale; // Sprite size multiplier for the current resolution
+
+out vec3 StarColor;
+
+// Rough B-V to RGB: hot blue-white stars through white to cool orange-red
+vec3 colorFromIndex(float bv) {
+    float t = clamp((bv + 0.4) / 2.4, 0.0, 1.0);
+    vec3 hot = vec3(0.62, 0.72, 1.0);
+    vec3 white = vec3(1.0, 0.97, 0.92);
+    vec3 cool = vec3(1.0, 0.62, 0.35);
+    return mix(mix(hot, white, smoothstep(0.0, 0.35, t)), cool, smoothstep(0.35, 1.0, t));
+}
+
+void main() {
+    float magnitude = aMagnitude / 20.0 - 2.0;
+    float colorIndex = aColorIndex / 100.0 - 0.5;
+
+    // Flux relative to the naked-eye limit (mag 6.5), compressed logarithmically for display
+    float logFlux = 0.4 * (6.5 - magnitude) * 2.302585;
+    float brightness = clamp(0.25 + logFlux * 0.12, 0.25, 1.0);
+
+    StarColor = colorFromIndex(colorIndex) * brightness;
+    gl_PointSize = pointScale * (1.0 + logFlux * 0.35);
+
+    // Same far-plane trick as the skybox: depth 1.0, hidden behind any planet
+    vec4 pos = projection * view * vec4(aDirection, 1.0);
+#ifdef REVERSED_Z
+    gl_Position = vec4(pos.xy, 0.0, pos.w);
+#else
+    gl_Position = pos.xyww;
+#endif
+}
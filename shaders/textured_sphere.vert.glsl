@@ -7,9 +7,13 @@ uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
 
 out vec2 TexCoord;
-out vec3 FragPos;  // Fragment position in world space
+out vec3 FragPos;  // Fragment position in world axes, relative to the camera
 out vec3 Normal;   // Normal in world space
 
+#ifdef LOG_DEPTH
+out float LogDepthW; // 1 + clip w, interpolated for per-fragment logarithmic depth
+#endif
+
 void main() {
     vec4 worldPos = worldMatrix * vec4(aPos, 1.0);
     FragPos = vec3(worldPos);
@@ -19,4 +23,7 @@ void main() {
     
     TexCoord = aTexCoord;
     gl_Position = projectionMatrix * viewMatrix * worldPos;
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
 }
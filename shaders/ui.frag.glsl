@@ -2,14 +2,18 @@
 out vec4 FragColor;
 
 in vec2 TexCoord;
+in vec4 Color;
 
-uniform sampler2D ourTexture;
+uniform sampler2D atlas;
 uniform float alpha;
 
 void main() {
-    vec4 texColor = texture(ourTexture, TexCoord);
-    if(texColor.a < 0.1) {
+    // Distance field: 0.5 on the glyph outline, antialiased over about one screen pixel at any text size
+    float distance = texture(atlas, TexCoord).r;
+    float width = max(fwidth(distance) * 0.75, 1e-4);
+    float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+    if (coverage <= 0.0) {
         discard;
     }
-    FragColor = vec4(texColor.rgb, texColor.a * alpha);
+    FragColor = vec4(Color.rgb, Color.a * coverage * alpha);
 }
@@ -1,12 +1,16 @@
 #version 330 core
-layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec2 aTexCoord;
+layout (location = 0) in vec2 aPos;      // Pixels from the top-left of the text block, y down
+layout (location = 1) in vec2 aTexCoord; // Distance field atlas
+layout (location = 2) in vec4 aColor;
 
 out vec2 TexCoord;
+out vec4 Color;
 
 uniform mat4 projection;
+uniform vec2 origin; // Top-left of the block in window pixels, y up
 
 void main() {
-    gl_Position = projection * vec4(aPos.x, aPos.y, 0.0, 1.0);
+    gl_Position = projection * vec4(origin.x + aPos.x, origin.y - aPos.y, 0.0, 1.0);
     TexCoord = aTexCoord;
+    Color = aColor;
 }
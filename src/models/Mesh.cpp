@@ -1,41 +1,31 @@
 #include "include/models/Mesh.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
 #include <iostream>
 
-void Mesh::setupMesh() {
-    GLuint VBO, normalVBO, texVBO, EBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &normalVBO);
-    glGenBuffers(1, &texVBO);
-    glGenBuffers(1, &EBO);
+void Mesh::upload(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t count) {
+    VAO = GlVertexArray::create();
+    vertexBuffer = GlBuffer::create();
+    indexBuffer = GlBuffer::create();
+    indexCount = unsigned(count);
 
-    glBindVertexArray(VAO);
+    RenderState::bindVertexArray(VAO);
 
-    // Vertex positions
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
+    // Positions, normals and texture coordinates interleaved in one buffer
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, vertexBuffer, MemoryBudget::Geometry, vertexCount * sizeof(Vertex));
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-
-    // Normals
-    if (!normals.empty()) {
-        glBindBuffer(GL_ARRAY_BUFFER, normalVBO);
-        glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(glm::vec3), &normals[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    }
-
-    // Texture coordinates
-    if (!texCoords.empty()) {
-        glBindBuffer(GL_ARRAY_BUFFER, texVBO);
-        glBufferData(GL_ARRAY_BUFFER, texCoords.size() * sizeof(glm::vec2), &texCoords[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    }
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
 
     // Indices
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, indexBuffer, MemoryBudget::Geometry, count * sizeof(unsigned int));
 
-    glBindVertexArray(0);
+    RenderState::bindVertexArray(0);
 }
@@ -0,0 +1,394 @@
+#include "include/models/MeshCache.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include "include/utils/AssetPack.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+const char MAGIC[4] = {'S', 'M', 'S', 'H'};
+
+void hashBytes(const char* bytes, size_t size, uint64_t& hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ uint64_t(uint8_t(bytes[i]))) * 0x100000001B3ull;
+    }
+}
+
+// FNV-1a over a whole file, folded into hash: in place from the pack, else streamed from the loose file
+bool hashFile(const std::string& path, uint64_t& hash) {
+    std::string_view packed;
+    if (AssetPack::find(path, packed)) {
+        hashBytes(packed.data(), packed.size(), hash);
+        return true;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    char chunk[65536];
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        hashBytes(chunk, size_t(file.gcount()), hash);
+    }
+    return true;
+}
+
+// External files named by "uri" entries in a glTF, except images and embedded data
+std::vector<std::string> gltfBuffers(const std::string& gltfPath) {
+    std::string_view text;
+    std::string loose;
+    if (!AssetPack::find(gltfPath, text)) {
+        AssetPack::read(gltfPath, loose);
+        text = loose;
+    }
+    std::vector<std::string> uris;
+    for (size_t key = text.find("\"uri\""); key != std::string::npos; key = text.find("\"uri\"", key + 5)) {
+        size_t open = text.find('"', text.find(':', key + 5));
+        size_t close = open == std::string::npos ? open : text.find('"', open + 1);
+        if (close == std::string::npos) {
+            break;
+        }
+        std::string uri(text.substr(open + 1, close - open - 1));
+        std::string extension = std::filesystem::path(uri).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        bool image = extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".ktx2";
+        if (!image && uri.rfind("data:", 0) != 0) {
+            uris.push_back(uri);
+        }
+    }
+    return uris;
+}
+
+// Read-only stream over an asset held in the pack
+class PackIOStream : public Assimp::IOStream {
+public:
+    explicit PackIOStream(std::string_view contents) : contents(contents) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override {
+        if (size == 0) {
+            return 0;
+        }
+        size_t items = std::min(count, (contents.size() - position) / size);
+        std::memcpy(buffer, contents.data() + position, items * size);
+        position += items * size;
+        return items;
+    }
+
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        size_t base = origin == aiOrigin_SET ? 0 : origin == aiOrigin_CUR ? position : contents.size();
+        if (base + offset > contents.size()) {
+            return aiReturn_FAILURE;
+        }
+        position = base + offset;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override { return position; }
+    size_t FileSize() const override { return contents.size(); }
+    void Flush() override {}
+
+private:
+    std::string_view contents;
+    size_t position = 0;
+};
+
+// Serves the model and the buffers it references from the asset pack, other files from disk
+class PackIOSystem : public Assimp::DefaultIOSystem {
+public:
+    bool Exists(const char* file) const override {
+        std::string_view contents;
+        return AssetPack::find(file, contents) || Assimp::DefaultIOSystem::Exists(file);
+    }
+
+    Assimp::IOStream* Open(const char* file, const char* mode) override {
+        std::string_view contents;
+        if (std::strchr(mode, 'w') == nullptr && AssetPack::find(file, contents)) {
+            return new PackIOStream(contents);
+        }
+        return Assimp::DefaultIOSystem::Open(file, mode);
+    }
+
+    void Close(Assimp::IOStream* stream) override { delete stream; }
+};
+
+// Structural checks so a damaged or hand-made cache cannot send reads or draws outside its buffers
+bool validate(const unsigned char* data, size_t size) {
+    if (size < sizeof(MeshCache::FileHeader)) {
+        return false;
+    }
+    const MeshCache::FileHeader* header = reinterpret_cast<const MeshCache::FileHeader*>(data);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != MeshCache::VERSION) {
+        return false;
+    }
+    uint64_t expected = sizeof(MeshCache::FileHeader) + uint64_t(header->meshCount) * sizeof(MeshCache::MeshRecord) +
+                        uint64_t(header->materialCount) * sizeof(MeshCache::MaterialRecord) +
+                        uint64_t(header->vertexCount) * sizeof(Mesh::Vertex) +
+                        uint64_t(header->indexCount) * sizeof(uint32_t) + header->stringBytes;
+    if (expected != size || header->stringBytes == 0 || data[size - 1] != '\0') {
+        return false;
+    }
+
+    const MeshCache::MeshRecord* meshes = reinterpret_cast<const MeshCache::MeshRecord*>(header + 1);
+    const MeshCache::MaterialRecord* materials =
+        reinterpret_cast<const MeshCache::MaterialRecord*>(meshes + header->meshCount);
+    const Mesh::Vertex* vertices = reinterpret_cast<const Mesh::Vertex*>(materials + header->materialCount);
+    const uint32_t* indices = reinterpret_cast<const uint32_t*>(vertices + header->vertexCount);
+    for (uint32_t i = 0; i < header->materialCount; i++) {
+        if (materials[i].diffuseTexture >= header->stringBytes) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->meshCount; i++) {
+        const MeshCache::MeshRecord& mesh = meshes[i];
+        if (uint64_t(mesh.firstVertex) + mesh.vertexCount > header->vertexCount ||
+            uint64_t(mesh.firstIndex) + mesh.indexCount > header->indexCount || mesh.material >= header->materialCount) {
+            return false;
+        }
+        for (uint32_t j = 0; j < mesh.indexCount; j++) {
+            if (indices[mesh.firstIndex + j] >= mesh.vertexCount) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}
+
+MeshCache MeshCache::load(const std::string& modelPath, const std::string& cachePath) {
+    MeshCache cache;
+    uint64_t hash = sourceHash(modelPath);
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int fd = open(cachePath.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            void* mapped = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd); // The mapping stays valid after the descriptor is closed
+
+            if (mapped != MAP_FAILED) {
+                const unsigned char* data = static_cast<const unsigned char*>(mapped);
+                // Without the source (e.g. a shipped cache), an intact cache is used as is
+                if (validate(data, info.st_size) && (hash == 0 || reinterpret_cast<const FileHeader*>(data)->sourceHash == hash)) {
+                    cache.data = data;
+                    cache.size = info.st_size;
+                    MemoryBudget::trackCpu(MemoryBudget::Caches, int64_t(cache.size));
+                    return cache;
+                }
+                munmap(mapped, info.st_size);
+            }
+        }
+
+        if (attempt == 0 && hash != 0) {
+            std::cout << "Converting model " << modelPath << " into " << cachePath << std::endl;
+            if (!compile(modelPath, cachePath, hash)) {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    std::cerr << "Failed to load model: " << modelPath << std::endl;
+    return cache;
+}
+
+bool MeshCache::compile(const std::string& modelPath, const std::string& cachePath, uint64_t sourceHash) {
+    Assimp::Importer importer;
+    if (AssetPack::mounted()) {
+        importer.SetIOHandler(new PackIOSystem()); // Owned by the importer
+    }
+    const aiScene* scene = importer.ReadFile(modelPath,
+        aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_FlipUVs |
+        aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
+        aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices);
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        std::cerr << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+
+    // Materials: the diffuse texture path of each, deduplicated into the string table
+    std::string strings(1, '\0');
+    std::unordered_map<std::string, uint32_t> offsets;
+    std::vector<MaterialRecord> materials(std::max(1u, scene->mNumMaterials), MaterialRecord{0});
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        aiString texturePath;
+        if (scene->mMaterials[i] &&
+            scene->mMaterials[i]->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
+            std::string path = texturePath.C_Str();
+            auto found = offsets.find(path);
+            if (found == offsets.end()) {
+                found = offsets.emplace(path, uint32_t(strings.size())).first;
+                strings += path;
+                strings += '\0';
+            }
+            materials[i].diffuseTexture = found->second;
+        }
+    }
+
+    // Meshes: PreTransformVertices has already baked the node transforms, so the mesh list is flat.
+    // A serial pass sizes each mesh and assigns its slice of the shared arrays, then the meshes are
+    // converted in parallel, each thread writing only its own slices.
+    std::vector<MeshRecord> meshes;
+    std::vector<const aiMesh*> sources;
+    uint32_t vertexTotal = 0, indexTotal = 0;
+    for (unsigned int m = 0; m < scene->mNumMeshes; m++) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        if (!mesh || mesh->mNumVertices == 0) {
+            continue;
+        }
+        // Triangulated, so faces have three indices; points and lines are dropped
+        uint32_t triangles = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+            triangles += mesh->mFaces[i].mNumIndices == 3;
+        }
+        if (triangles == 0) {
+            continue;
+        }
+
+        MeshRecord record;
+        record.firstVertex = vertexTotal;
+        record.vertexCount = mesh->mNumVertices;
+        record.firstIndex = indexTotal;
+        record.indexCount = triangles * 3;
+        record.material = mesh->mMaterialIndex < materials.size() ? mesh->mMaterialIndex : 0;
+        meshes.push_back(record);
+        sources.push_back(mesh);
+        vertexTotal += record.vertexCount;
+        indexTotal += record.indexCount;
+    }
+
+    std::vector<Mesh::Vertex> vertices(vertexTotal);
+    std::vector<uint32_t> indices(indexTotal);
+    parallelFor(meshes.size(), [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; m++) {
+            const aiMesh* mesh = sources[m];
+            Mesh::Vertex* vertex = vertices.data() + meshes[m].firstVertex;
+            for (unsigned int i = 0; i < mesh->mNumVertices; i++, vertex++) {
+                vertex->position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+                vertex->normal = mesh->HasNormals() ? glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z)
+                                                    : glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex->texCoord = mesh->mTextureCoords[0]
+                                       ? glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y)
+                                       : glm::vec2(0.0f, 0.0f);
+            }
+
+            uint32_t* index = indices.data() + meshes[m].firstIndex;
+            for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+                const aiFace& face = mesh->mFaces[i];
+                if (face.mNumIndices == 3) {
+                    index = std::copy(face.mIndices, face.mIndices + 3, index);
+                }
+            }
+        }
+    }, 1);
+
+    header.meshCount = uint32_t(meshes.size());
+    header.materialCount = uint32_t(materials.size());
+    header.vertexCount = uint32_t(vertices.size());
+    header.indexCount = uint32_t(indices.size());
+    header.stringBytes = uint32_t(strings.size());
+
+    // Write to a temporary file and rename, so a running instance never maps a half-written cache
+    std::string temporary = cachePath + ".tmp";
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(cachePath).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write mesh cache: " << temporary << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(meshes.data()), meshes.size() * sizeof(MeshRecord));
+    file.write(reinterpret_cast<const char*>(materials.data()), materials.size() * sizeof(MaterialRecord));
+    file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Mesh::Vertex));
+    file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+    file.write(strings.data(), strings.size());
+
+    file.close();
+    if (!file || std::rename(temporary.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to write mesh cache: " << cachePath << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint64_t MeshCache::sourceHash(const std::string& modelPath) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    if (!hashFile(modelPath, hash)) {
+        return 0;
+    }
+    std::string extension = std::filesystem::path(modelPath).extension().string();
+    if (extension == ".gltf") {
+        std::filesystem::path directory = std::filesystem::path(modelPath).parent_path();
+        for (const std::string& uri : gltfBuffers(modelPath)) {
+            if (!hashFile((directory / uri).string(), hash)) {
+                return 0; // Missing buffer, let Assimp report it
+            }
+        }
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+std::string MeshCache::cachePath(const std::string& modelPath) {
+    std::filesystem::path path(modelPath);
+    return "cache/" + path.parent_path().filename().string() + "_" + path.stem().string() + ".smsh";
+}
+
+const MeshCache::MeshRecord& MeshCache::mesh(uint32_t index) const {
+    return reinterpret_cast<const MeshRecord*>(data + sizeof(FileHeader))[index];
+}
+
+const MeshCache::MaterialRecord& MeshCache::material(uint32_t index) const {
+    const unsigned char* table = data + sizeof(FileHeader) + size_t(header().meshCount) * sizeof(MeshRecord);
+    return reinterpret_cast<const MaterialRecord*>(table)[index];
+}
+
+const Mesh::Vertex* MeshCache::vertices() const {
+    return reinterpret_cast<const Mesh::Vertex*>(&material(header().materialCount));
+}
+
+const uint32_t* MeshCache::indices() const {
+    return reinterpret_cast<const uint32_t*>(vertices() + header().vertexCount);
+}
+
+const char* MeshCache::string(uint32_t offset) const {
+    return reinterpret_cast<const char*>(data + size - header().stringBytes + offset);
+}
+
+void MeshCache::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+        MemoryBudget::trackCpu(MemoryBudget::Caches, -int64_t(size));
+        data = nullptr;
+        size = 0;
+    }
+}
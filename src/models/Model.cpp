@@ -1,18 +1,20 @@
-#include "include/utils/TextureUtils.hpp"
 #include "include/models/Mesh.hpp"
 #include "include/models/Model.hpp"
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
+#include "include/models/MeshCache.hpp"
+#include "include/utils/RenderState.hpp"
+#include "include/utils/TextureCache.hpp"
 #include <glm/glm.hpp>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <string>
 
 using namespace glm;
 
 void Model::Draw(GLuint shader) {
     for (const auto& mesh : meshes) {
         // Bind texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, mesh.texture);
+        RenderState::bindTexture(GL_TEXTURE_2D, mesh.texture);
         GLint texLocation = glGetUniformLocation(shader, "texture1");
         if (texLocation == -1) {
             std::cerr << "Warning: Uniform 'texture1' not found in shader" << std::endl;
@@ -20,114 +22,46 @@ void Model::Draw(GLuint shader) {
         glUniform1i(texLocation, 0);
 
         // Draw mesh
-        glBindVertexArray(mesh.VAO);
-        if (mesh.indices.empty()) {
-            std::cerr << "Warning: Mesh has no indices" << std::endl;
-        } else {
-            glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
-        }
-        glBindVertexArray(0);
-
-        // Check for OpenGL errors
-        GLenum err;
-        while ((err = glGetError()) != GL_NO_ERROR) {
-            std::cerr << "OpenGL error in Draw: " << err << std::endl;
-        }
+        RenderState::bindVertexArray(mesh.VAO);
+        glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
     }
 }
 
 Model Model::loadFromFile(const char* path) {
     Model model;
-    Assimp::Importer importer;
-    std::cout << "Attempting to load model from: " << path << std::endl;
-
-    const aiScene* scene = importer.ReadFile(path,
-        aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_FlipUVs |
-        aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
-        aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices);
-
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        std::cerr << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    MeshCache cache = MeshCache::load(path, MeshCache::cachePath(path));
+    if (!cache.valid()) {
         return model;
     }
 
-    std::cout << "Model loaded successfully. Number of meshes: " << scene->mNumMeshes << std::endl;
-    std::cout << "Number of materials: " << scene->mNumMaterials << std::endl;
-    std::cout << "Number of children in root node: " << scene->mRootNode->mNumChildren << std::endl;
-
-    // Process all nodes recursively starting from the root
-    processNode(model, scene->mRootNode, scene);
-
-    return model;
-}
-
-void Model::processNode(Model& model, aiNode* node, const aiScene* scene) {
-    // Process all meshes in this node
-    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        if (!mesh) {
-            std::cerr << "Warning: Null mesh encountered" << std::endl;
-            continue;
-        }
-
-        std::cout << "Processing mesh with " << mesh->mNumVertices << " vertices" << std::endl;
-
-        Mesh newMesh;
-
-        // Load material/texture first
-        if (mesh->mMaterialIndex >= 0) {
-            aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-            if (material) {
-                aiString texturePath;
-                if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
-                    std::string fullPath = std::string("models/rubber_duck/textures/material_baseColor.jpeg");
-                    std::cout << "Loading texture from: " << fullPath << std::endl;
-                    newMesh.texture = TextureUtils::loadTexture(fullPath.c_str());
-                    if (newMesh.texture == 0)
-                    {
-                        std::cerr << "Failed to load texture!" << std::endl;
-                    }
-                    else
-                    {
-                        std::cout << "Texture loaded successfully with ID: " << newMesh.texture << std::endl;
-                    }
-                }
-            }
-        }
-
-        // Process vertices
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-            newMesh.vertices.push_back(vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z));
-
-            if (mesh->HasNormals()) {
-                newMesh.normals.push_back(vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z));
-            }
-
-            if (mesh->mTextureCoords[0]) {
-                newMesh.texCoords.push_back(vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y));
-            } else {
-                newMesh.texCoords.push_back(vec2(0.0f, 0.0f));
-            }
-        }
-
-        // Process indices
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            for (unsigned int j = 0; j < face.mNumIndices; j++) {
-                newMesh.indices.push_back(face.mIndices[j]);
-            }
-        }
-
-        if (!newMesh.vertices.empty() && !newMesh.indices.empty()) {
-            newMesh.setupMesh();
-            model.meshes.push_back(newMesh);
-            std::cout << "Added mesh with " << newMesh.vertices.size() << " vertices and " 
-                     << newMesh.indices.size() << " indices" << std::endl;
+    // Every distinct texture the materials name, decoded together and shared through the texture cache.
+    // Paths are relative to the model.
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    const MeshCache::FileHeader& header = cache.header();
+    std::vector<std::string> texturePaths(header.materialCount);
+    for (uint32_t i = 0; i < header.materialCount; i++) {
+        const char* texturePath = cache.string(cache.material(i).diffuseTexture);
+        if (texturePath[0] != '\0') {
+            texturePaths[i] = (directory / texturePath).string();
         }
     }
-
-    // Recursively process child nodes
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(model, node->mChildren[i], scene);
+    TextureCache::preload(texturePaths);
+
+    // Straight from the mapping into GL buffers
+    model.meshes.reserve(header.meshCount);
+    for (uint32_t i = 0; i < header.meshCount; i++) {
+        const MeshCache::MeshRecord& record = cache.mesh(i);
+        Mesh& mesh = model.meshes.emplace_back();
+        const std::string& texturePath = texturePaths[record.material];
+        mesh.texture = texturePath.empty() ? 0 : TextureCache::get(texturePath);
+        mesh.upload(cache.vertices() + record.firstVertex, record.vertexCount, cache.indices() + record.firstIndex,
+                    record.indexCount);
     }
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Model " << path << ": " << header.meshCount << " meshes, " << header.vertexCount << " vertices, "
+              << header.indexCount / 3 << " triangles in " << milliseconds << " ms" << std::endl;
+    cache.close();
+    return model;
 }
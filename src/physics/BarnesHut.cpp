@@ -0,0 +1,353 @@
+#include "include/physics/BarnesHut.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace {
+// Spreads the low 21 bits of v so there are two zero bits between each
+uint64_t spreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+// Octant of a code at the given tree level (0 = root's children)
+int octantAt(uint64_t code, int level) {
+    return static_cast<int>((code >> (3 * (BarnesHut::MAX_DEPTH - level - 1))) & 7);
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+BarnesHut::BarnesHut(double theta) : theta(theta), lastStats{0.0, 0.0, 0} {}
+
+void BarnesHut::accumulateLeaf(Node& node) const {
+    node.mass = 0.0;
+    node.comX = node.comY = node.comZ = 0.0;
+    for (uint32_t i = node.begin; i < node.end; i++) {
+        node.mass += sortedMass[i];
+        node.comX += sortedMass[i] * sortedX[i];
+        node.comY += sortedMass[i] * sortedY[i];
+        node.comZ += sortedMass[i] * sortedZ[i];
+    }
+    if (node.mass > 0.0) {
+        node.comX /= node.mass;
+        node.comY /= node.mass;
+        node.comZ /= node.mass;
+    } else {
+        node.comX = sortedX[node.begin];
+        node.comY = sortedY[node.begin];
+        node.comZ = sortedZ[node.begin];
+    }
+}
+
+// Fills out[slot] for particles [begin, end) that share their top 3 * level Morton bits.
+// With deferred set, recursion stops at PARALLEL_DEPTH and the slot is recorded for a worker instead.
+void BarnesHut::buildNode(std::vector<Node>& out, int32_t slot, uint32_t begin, uint32_t end, int level, double size,
+                          std::vector<int32_t>* deferred) {
+    Node node;
+    node.begin = begin;
+    node.end = end;
+    node.size = size;
+    node.firstChild = -1;
+    node.childCount = 0;
+
+    if (end - begin <= static_cast<uint32_t>(LEAF_CAPACITY) || level == MAX_DEPTH) {
+        accumulateLeaf(node);
+        out[slot] = node;
+        return;
+    }
+    if (deferred && level == PARALLEL_DEPTH) {
+        out[slot] = node;
+        deferred->push_back(slot);
+        return;
+    }
+
+    // Codes are sorted, so within this cell each octant is a contiguous run
+    uint32_t childBegin[8], childEnd[8];
+    uint32_t cursor = begin;
+    for (int octant = 0; octant < 8; octant++) {
+        childBegin[octant] = cursor;
+        cursor = static_cast<uint32_t>(std::partition_point(codes.begin() + cursor, codes.begin() + end,
+                                                            [&](uint64_t code) { return octantAt(code, level) <= octant; }) -
+                                       codes.begin());
+        childEnd[octant] = cursor;
+    }
+
+    for (int octant = 0; octant < 8; octant++) {
+        if (childEnd[octant] > childBegin[octant]) {
+            node.childCount++;
+        }
+    }
+    node.firstChild = static_cast<int32_t>(out.size());
+    out.resize(out.size() + node.childCount);
+
+    int32_t child = node.firstChild;
+    for (int octant = 0; octant < 8; octant++) {
+        if (childEnd[octant] > childBegin[octant]) {
+            buildNode(out, child++, childBegin[octant], childEnd[octant], level + 1, size * 0.5, deferred);
+        }
+    }
+
+    // In the serial pass deferred cells have no moments yet, build() sums those levels after the workers finish
+    if (!deferred) {
+        node.mass = node.comX = node.comY = node.comZ = 0.0;
+        for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+            node.mass += out[c].mass;
+            node.comX += out[c].mass * out[c].comX;
+            node.comY += out[c].mass * out[c].comY;
+            node.comZ += out[c].mass * out[c].comZ;
+        }
+        if (node.mass > 0.0) {
+            node.comX /= node.mass;
+            node.comY /= node.mass;
+            node.comZ /= node.mass;
+        }
+    }
+    out[slot] = node;
+}
+
+void BarnesHut::build(const NBodySystem& system) {
+    auto start = std::chrono::steady_clock::now();
+    size_t count = system.size();
+    nodes.clear();
+    if (count == 0) {
+        lastStats.buildSeconds = 0.0;
+        lastStats.nodeCount = 0;
+        return;
+    }
+
+    // Bounding cube
+    double minX = system.x[0], minY = system.y[0], minZ = system.z[0];
+    double maxX = minX, maxY = minY, maxZ = minZ;
+    for (size_t i = 1; i < count; i++) {
+        minX = std::min(minX, system.x[i]);
+        minY = std::min(minY, system.y[i]);
+        minZ = std::min(minZ, system.z[i]);
+        maxX = std::max(maxX, system.x[i]);
+        maxY = std::max(maxY, system.y[i]);
+        maxZ = std::max(maxZ, system.z[i]);
+    }
+    double rootSize = std::max({maxX - minX, maxY - minY, maxZ - minZ, 1e-12}) * 1.0001;
+    double scale = double(1 << MAX_DEPTH) / rootSize;
+
+    // Morton codes paired with particle indices, sorted in parallel chunks and merged pairwise
+    std::vector<std::pair<uint64_t, uint32_t>> keys(count);
+    const uint64_t maxCell = (1u << MAX_DEPTH) - 1;
+    parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint64_t qx = std::min<uint64_t>(static_cast<uint64_t>((system.x[i] - minX) * scale), maxCell);
+            uint64_t qy = std::min<uint64_t>(static_cast<uint64_t>((system.y[i] - minY) * scale), maxCell);
+            uint64_t qz = std::min<uint64_t>(static_cast<uint64_t>((system.z[i] - minZ) * scale), maxCell);
+            keys[i] = {spreadBits(qx) << 2 | spreadBits(qy) << 1 | spreadBits(qz), static_cast<uint32_t>(i)};
+        }
+    });
+
+    const size_t sortChunk = 16384;
+    size_t chunkCount = (count + sortChunk - 1) / sortChunk;
+    parallelFor(chunkCount, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            std::sort(keys.begin() + c * sortChunk, keys.begin() + std::min((c + 1) * sortChunk, count));
+        }
+    }, 1);
+    for (size_t width = sortChunk; width < count; width *= 2) {
+        size_t pairCount = (count + 2 * width - 1) / (2 * width);
+        parallelFor(pairCount, [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; p++) {
+                size_t lo = p * 2 * width;
+                size_t mid = std::min(lo + width, count);
+                size_t hi = std::min(lo + 2 * width, count);
+                std::inplace_merge(keys.begin() + lo, keys.begin() + mid, keys.begin() + hi);
+            }
+        }, 1);
+    }
+
+    // Sorted copies keep leaf loops and tree walks on contiguous memory
+    order.resize(count);
+    codes.resize(count);
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedZ.resize(count);
+    sortedMass.resize(count);
+    parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; s++) {
+            uint32_t i = keys[s].second;
+            codes[s] = keys[s].first;
+            order[s] = i;
+            sortedX[s] = system.x[i];
+            sortedY[s] = system.y[i];
+            sortedZ[s] = system.z[i];
+            sortedMass[s] = system.mass[i];
+        }
+    });
+
+    // Top levels serially, recording the cells whose subtrees go to workers
+    std::vector<int32_t> deferred;
+    nodes.resize(1);
+    buildNode(nodes, 0, 0, static_cast<uint32_t>(count), 0, rootSize, &deferred);
+    size_t serialCount = nodes.size();
+
+    std::vector<std::vector<Node>> subtrees(deferred.size());
+    parallelFor(deferred.size(), [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            const Node& cell = nodes[deferred[t]];
+            subtrees[t].resize(1);
+            buildNode(subtrees[t], 0, cell.begin, cell.end, PARALLEL_DEPTH, cell.size, nullptr);
+        }
+    }, 1);
+
+    // Splice each subtree behind the serial levels: its root replaces the deferred cell, the rest is appended
+    std::vector<size_t> offsets(deferred.size());
+    size_t total = serialCount;
+    for (size_t t = 0; t < deferred.size(); t++) {
+        offsets[t] = total - 1; // Local index 1 lands at 'total'
+        total += subtrees[t].size() - 1;
+    }
+    nodes.resize(total);
+    parallelFor(deferred.size(), [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            int32_t offset = static_cast<int32_t>(offsets[t]);
+            for (size_t j = 0; j < subtrees[t].size(); j++) {
+                Node node = subtrees[t][j];
+                if (node.firstChild >= 0) {
+                    node.firstChild += offset;
+                }
+                nodes[j == 0 ? deferred[t] : offset + j] = node;
+            }
+        }
+    }, 1);
+
+    // Children always follow their parent, so walking the serial levels backwards sums bottom-up
+    for (size_t i = serialCount; i-- > 0;) {
+        Node& node = nodes[i];
+        if (node.firstChild < 0) {
+            continue;
+        }
+        node.mass = node.comX = node.comY = node.comZ = 0.0;
+        for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+            node.mass += nodes[c].mass;
+            node.comX += nodes[c].mass * nodes[c].comX;
+            node.comY += nodes[c].mass * nodes[c].comY;
+            node.comZ += nodes[c].mass * nodes[c].comZ;
+        }
+        if (node.mass > 0.0) {
+            node.comX /= node.mass;
+            node.comY /= node.mass;
+            node.comZ /= node.mass;
+        }
+    }
+
+    lastStats.buildSeconds = secondsSince(start);
+    lastStats.nodeCount = nodes.size();
+}
+
+void BarnesHut::computeAccelerations(NBodySystem& system) {
+    build(system);
+    auto start = std::chrono::steady_clock::now();
+
+    size_t count = system.size();
+    double theta2 = theta * theta;
+    double softening2 = system.softening * system.softening;
+    double G = system.gravitationalConstant;
+
+    // Walk in Morton order so neighbouring particles on a thread visit the same cells
+    parallelFor(count, [&](size_t begin, size_t end) {
+        int32_t stack[8 * MAX_DEPTH + 8];
+        for (size_t s = begin; s < end; s++) {
+            double px = sortedX[s], py = sortedY[s], pz = sortedZ[s];
+            double accX = 0.0, accY = 0.0, accZ = 0.0;
+
+            int top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const Node& node = nodes[stack[--top]];
+                bool containsSelf = s >= node.begin && s < node.end;
+
+                if (node.firstChild < 0) {
+                    for (uint32_t j = node.begin; j < node.end; j++) {
+                        if (j == s) {
+                            continue;
+                        }
+                        double dx = sortedX[j] - px;
+                        double dy = sortedY[j] - py;
+                        double dz = sortedZ[j] - pz;
+                        double r2 = dx * dx + dy * dy + dz * dz + softening2;
+                        if (r2 == 0.0) {
+                            continue;
+                        }
+                        double invR = 1.0 / std::sqrt(r2);
+                        double f = sortedMass[j] * invR * invR * invR;
+                        accX += f * dx;
+                        accY += f * dy;
+                        accZ += f * dz;
+                    }
+                    continue;
+                }
+
+                double dx = node.comX - px;
+                double dy = node.comY - py;
+                double dz = node.comZ - pz;
+                double r2 = dx * dx + dy * dy + dz * dz;
+                if (!containsSelf && node.size * node.size < theta2 * r2) {
+                    // Far enough away: the whole cell acts as one mass at its center of mass
+                    double invR = 1.0 / std::sqrt(r2 + softening2);
+                    double f = node.mass * invR * invR * invR;
+                    accX += f * dx;
+                    accY += f * dy;
+                    accZ += f * dz;
+                } else {
+                    for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+                        stack[top++] = c;
+                    }
+                }
+            }
+
+            uint32_t i = order[s];
+            system.ax[i] = G * accX;
+            system.ay[i] = G * accY;
+            system.az[i] = G * accZ;
+        }
+    }, 64);
+
+    system.accelerationsValid = true;
+    lastStats.forceSeconds = secondsSince(start);
+}
+
+void BarnesHut::step(NBodySystem& system, double dt) {
+    if (!system.accelerationsValid) {
+        computeAccelerations(system);
+    }
+
+    size_t count = system.size();
+    double halfDt = 0.5 * dt;
+
+    // Kick half a step, drift a full step
+    parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            system.vx[i] += system.ax[i] * halfDt;
+            system.vy[i] += system.ay[i] * halfDt;
+            system.vz[i] += system.az[i] * halfDt;
+            system.x[i] += system.vx[i] * dt;
+            system.y[i] += system.vy[i] * dt;
+            system.z[i] += system.vz[i] * dt;
+        }
+    }, 4096);
+
+    // Kick the second half with the forces at the new positions
+    computeAccelerations(system);
+    parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            system.vx[i] += system.ax[i] * halfDt;
+            system.vy[i] += system.ay[i] * halfDt;
+            system.vz[i] += system.az[i] * halfDt;
+        }
+    }, 4096);
+}
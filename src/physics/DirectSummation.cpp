@@ -0,0 +1,199 @@
+#include "include/physics/DirectSummation.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+namespace {
+// Adds the pull of sources [j0, j1) on LANES consecutive targets starting at i.
+// Pairs at zero distance (the target itself when unsoftened) contribute nothing.
+#if defined(__AVX512F__)
+constexpr size_t LANES = 8;
+
+void interactTile(const NBodySystem& s, size_t i, size_t j0, size_t j1, double softening2,
+                  double* ax, double* ay, double* az) {
+    __m512d px = _mm512_loadu_pd(&s.x[i]);
+    __m512d py = _mm512_loadu_pd(&s.y[i]);
+    __m512d pz = _mm512_loadu_pd(&s.z[i]);
+    __m512d accX = _mm512_loadu_pd(ax);
+    __m512d accY = _mm512_loadu_pd(ay);
+    __m512d accZ = _mm512_loadu_pd(az);
+    __m512d eps2 = _mm512_set1_pd(softening2);
+    __m512d one = _mm512_set1_pd(1.0);
+    __m512d zero = _mm512_setzero_pd();
+
+    for (size_t j = j0; j < j1; j++) {
+        __m512d dx = _mm512_sub_pd(_mm512_set1_pd(s.x[j]), px);
+        __m512d dy = _mm512_sub_pd(_mm512_set1_pd(s.y[j]), py);
+        __m512d dz = _mm512_sub_pd(_mm512_set1_pd(s.z[j]), pz);
+        __m512d r2 = _mm512_fmadd_pd(dx, dx, _mm512_fmadd_pd(dy, dy, _mm512_fmadd_pd(dz, dz, eps2)));
+        __mmask8 valid = _mm512_cmp_pd_mask(r2, zero, _CMP_GT_OQ);
+        __m512d invR = _mm512_maskz_div_pd(valid, one, _mm512_sqrt_pd(r2));
+        __m512d f = _mm512_mul_pd(_mm512_set1_pd(s.mass[j]), _mm512_mul_pd(invR, _mm512_mul_pd(invR, invR)));
+        accX = _mm512_fmadd_pd(f, dx, accX);
+        accY = _mm512_fmadd_pd(f, dy, accY);
+        accZ = _mm512_fmadd_pd(f, dz, accZ);
+    }
+
+    _mm512_storeu_pd(ax, accX);
+    _mm512_storeu_pd(ay, accY);
+    _mm512_storeu_pd(az, accZ);
+}
+
+const char* KERNEL_NAME = "avx512";
+#elif defined(__AVX2__) && defined(__FMA__)
+constexpr size_t LANES = 4;
+
+void interactTile(const NBodySystem& s, size_t i, size_t j0, size_t j1, double softening2,
+                  double* ax, double* ay, double* az) {
+    __m256d px = _mm256_loadu_pd(&s.x[i]);
+    __m256d py = _mm256_loadu_pd(&s.y[i]);
+    __m256d pz = _mm256_loadu_pd(&s.z[i]);
+    __m256d accX = _mm256_loadu_pd(ax);
+    __m256d accY = _mm256_loadu_pd(ay);
+    __m256d accZ = _mm256_loadu_pd(az);
+    __m256d eps2 = _mm256_set1_pd(softening2);
+    __m256d one = _mm256_set1_pd(1.0);
+    __m256d zero = _mm256_setzero_pd();
+
+    for (size_t j = j0; j < j1; j++) {
+        __m256d dx = _mm256_sub_pd(_mm256_set1_pd(s.x[j]), px);
+        __m256d dy = _mm256_sub_pd(_mm256_set1_pd(s.y[j]), py);
+        __m256d dz = _mm256_sub_pd(_mm256_set1_pd(s.z[j]), pz);
+        __m256d r2 = _mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_fmadd_pd(dz, dz, eps2)));
+        __m256d valid = _mm256_cmp_pd(r2, zero, _CMP_GT_OQ);
+        __m256d invR = _mm256_and_pd(valid, _mm256_div_pd(one, _mm256_sqrt_pd(r2)));
+        __m256d f = _mm256_mul_pd(_mm256_set1_pd(s.mass[j]), _mm256_mul_pd(invR, _mm256_mul_pd(invR, invR)));
+        accX = _mm256_fmadd_pd(f, dx, accX);
+        accY = _mm256_fmadd_pd(f, dy, accY);
+        accZ = _mm256_fmadd_pd(f, dz, accZ);
+    }
+
+    _mm256_storeu_pd(ax, accX);
+    _mm256_storeu_pd(ay, accY);
+    _mm256_storeu_pd(az, accZ);
+}
+
+const char* KERNEL_NAME = "avx2";
+#else
+// Portable path (ARM Macs, or x86 built without -mavx2 -mfma); fixed-width lanes leave room for auto-vectorization
+constexpr size_t LANES = 4;
+
+void interactTile(const NBodySystem& s, size_t i, size_t j0, size_t j1, double softening2,
+                  double* ax, double* ay, double* az) {
+    for (size_t j = j0; j < j1; j++) {
+        for (size_t lane = 0; lane < LANES; lane++) {
+            double dx = s.x[j] - s.x[i + lane];
+            double dy = s.y[j] - s.y[i + lane];
+            double dz = s.z[j] - s.z[i + lane];
+            double r2 = dx * dx + dy * dy + dz * dz + softening2;
+            double invR = r2 > 0.0 ? 1.0 / std::sqrt(r2) : 0.0;
+            double f = s.mass[j] * invR * invR * invR;
+            ax[lane] += f * dx;
+            ay[lane] += f * dy;
+            az[lane] += f * dz;
+        }
+    }
+}
+
+const char* KERNEL_NAME = "scalar";
+#endif
+
+// One target at a time, for the block tail that does not fill a vector
+void interactTileSingle(const NBodySystem& s, size_t i, size_t j0, size_t j1, double softening2,
+                        double& ax, double& ay, double& az) {
+    for (size_t j = j0; j < j1; j++) {
+        double dx = s.x[j] - s.x[i];
+        double dy = s.y[j] - s.y[i];
+        double dz = s.z[j] - s.z[i];
+        double r2 = dx * dx + dy * dy + dz * dz + softening2;
+        double invR = r2 > 0.0 ? 1.0 / std::sqrt(r2) : 0.0;
+        double f = s.mass[j] * invR * invR * invR;
+        ax += f * dx;
+        ay += f * dy;
+        az += f * dz;
+    }
+}
+}
+
+const char* DirectSummation::kernelName() {
+    return KERNEL_NAME;
+}
+
+void DirectSummation::computeAccelerations(NBodySystem& system) {
+    auto start = std::chrono::steady_clock::now();
+    size_t count = system.size();
+    double softening2 = system.softening * system.softening;
+    double G = system.gravitationalConstant;
+    size_t blockCount = (count + BLOCK - 1) / BLOCK;
+
+    parallelFor(blockCount, [&](size_t firstBlock, size_t lastBlock) {
+        double accX[BLOCK], accY[BLOCK], accZ[BLOCK];
+        for (size_t block = firstBlock; block < lastBlock; block++) {
+            size_t begin = block * BLOCK;
+            size_t end = std::min(begin + BLOCK, count);
+            size_t vectorEnd = begin + (end - begin) / LANES * LANES;
+            std::fill(accX, accX + BLOCK, 0.0);
+            std::fill(accY, accY + BLOCK, 0.0);
+            std::fill(accZ, accZ + BLOCK, 0.0);
+
+            // Each source tile stays in L1 while every target in the block visits it
+            for (size_t j0 = 0; j0 < count; j0 += TILE) {
+                size_t j1 = std::min(j0 + TILE, count);
+                for (size_t i = begin; i < vectorEnd; i += LANES) {
+                    interactTile(system, i, j0, j1, softening2, &accX[i - begin], &accY[i - begin], &accZ[i - begin]);
+                }
+                for (size_t i = vectorEnd; i < end; i++) {
+                    interactTileSingle(system, i, j0, j1, softening2, accX[i - begin], accY[i - begin], accZ[i - begin]);
+                }
+            }
+
+            for (size_t i = begin; i < end; i++) {
+                system.ax[i] = G * accX[i - begin];
+                system.ay[i] = G * accY[i - begin];
+                system.az[i] = G * accZ[i - begin];
+            }
+        }
+    }, 1);
+
+    system.accelerationsValid = true;
+    lastStats.forceSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double interactions = double(count) * double(count > 0 ? count - 1 : 0);
+    lastStats.interactionsPerSecond = lastStats.forceSeconds > 0.0 ? interactions / lastStats.forceSeconds : 0.0;
+}
+
+void DirectSummation::step(NBodySystem& system, double dt) {
+    // Yoshida's triple-jump coefficients: drift c1 kick d1 drift c2 kick d2 drift c3 kick d3 drift c4
+    const double cubeRoot2 = std::cbrt(2.0);
+    const double w1 = 1.0 / (2.0 - cubeRoot2);
+    const double w0 = -cubeRoot2 * w1;
+    const double drifts[4] = {w1 * 0.5, (w0 + w1) * 0.5, (w0 + w1) * 0.5, w1 * 0.5};
+    const double kicks[3] = {w1, w0, w1};
+
+    size_t count = system.size();
+    for (int stage = 0; stage < 4; stage++) {
+        double driftDt = drifts[stage] * dt;
+        for (size_t i = 0; i < count; i++) {
+            system.x[i] += system.vx[i] * driftDt;
+            system.y[i] += system.vy[i] * driftDt;
+            system.z[i] += system.vz[i] * driftDt;
+        }
+        if (stage == 3) {
+            break;
+        }
+
+        computeAccelerations(system);
+        double kickDt = kicks[stage] * dt;
+        for (size_t i = 0; i < count; i++) {
+            system.vx[i] += system.ax[i] * kickDt;
+            system.vy[i] += system.ay[i] * kickDt;
+            system.vz[i] += system.az[i] * kickDt;
+        }
+    }
+    // Positions moved after the last force evaluation
+    system.accelerationsValid = false;
+}
@@ -0,0 +1,263 @@
+#include "include/physics/Ephemeris.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+// Segment lengths keep the fit error of 13 coefficients below a kilometre against the source
+const double SEGMENT_DAYS[KeplerianElements::BODY_COUNT] = {
+    16.0,   // Mercury
+    64.0,   // Venus
+    64.0,   // Earth
+    128.0,  // Mars
+    256.0,  // Jupiter
+    512.0,  // Saturn
+    1024.0, // Uranus
+    1024.0, // Neptune
+    16.0,   // Moon
+};
+
+// Chebyshev coefficients from samples at the Chebyshev nodes (c0 already halved)
+void fitSegment(KeplerianElements::Body body, double start, double length, double* coefficients) {
+    const int N = Ephemeris::COEFFICIENTS;
+    glm::dvec3 samples[N];
+    for (int k = 0; k < N; k++) {
+        double node = std::cos(M_PI * (k + 0.5) / N);
+        samples[k] = KeplerianElements::position(body, start + (node + 1.0) * 0.5 * length);
+    }
+
+    for (int j = 0; j < N; j++) {
+        glm::dvec3 sum(0.0);
+        for (int k = 0; k < N; k++) {
+            sum += samples[k] * std::cos(M_PI * j * (k + 0.5) / N);
+        }
+        sum *= (j == 0 ? 1.0 : 2.0) / N;
+        coefficients[j] = sum.x;
+        coefficients[N + j] = sum.y;
+        coefficients[2 * N + j] = sum.z;
+    }
+}
+
+// Clenshaw recurrence for sum c_j T_j(t)
+double clenshaw(const double* c, double t) {
+    double b1 = 0.0, b2 = 0.0;
+    for (int j = Ephemeris::COEFFICIENTS - 1; j >= 1; j--) {
+        double b0 = 2.0 * t * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b0;
+    }
+    return c[0] + t * b1 - b2;
+}
+}
+
+Ephemeris Ephemeris::load(const std::string& path, double startJulianDate, double endJulianDate) {
+    Ephemeris ephemeris;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            void* mapped = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(FileHeader)) {
+                mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd); // The mapping stays valid after the descriptor is closed
+
+            if (mapped != MAP_FAILED) {
+                const FileHeader* header = static_cast<const FileHeader*>(mapped);
+                bool matches = std::memcmp(header->magic, "SEPH", 4) == 0 && header->version == VERSION &&
+                               header->bodyCount == KeplerianElements::BODY_COUNT &&
+                               header->coefficientCount == COEFFICIENTS &&
+                               header->startJulianDate == startJulianDate && header->endJulianDate == endJulianDate &&
+                               size_t(info.st_size) >= sizeof(FileHeader) + header->bodyCount * sizeof(BodyRecord);
+
+                const BodyRecord* bodies = reinterpret_cast<const BodyRecord*>(header + 1);
+                for (uint32_t i = 0; matches && i < header->bodyCount; i++) {
+                    uint64_t end = bodies[i].offset + uint64_t(bodies[i].segmentCount) * 3 * COEFFICIENTS * sizeof(double);
+                    // position() clamps to segmentCount - 1, so an empty record would wrap and read far past the map
+                    matches = bodies[i].segmentCount > 0 && bodies[i].segmentDays > 0.0 && end <= uint64_t(info.st_size);
+                }
+
+                if (matches) {
+                    ephemeris.data = static_cast<const unsigned char*>(mapped);
+                    ephemeris.size = info.st_size;
+                    ephemeris.startJulianDate = startJulianDate;
+                    ephemeris.endJulianDate = endJulianDate;
+                    return ephemeris;
+                }
+                munmap(mapped, info.st_size);
+            }
+        }
+
+        if (attempt == 0) {
+            std::cout << "Building ephemeris cache " << path << " (" << calendarDate(startJulianDate) << " to "
+                      << calendarDate(endJulianDate) << ")" << std::endl;
+            if (!build(path, startJulianDate, endJulianDate)) {
+                break;
+            }
+        }
+    }
+
+    std::cerr << "Failed to load ephemeris cache: " << path << std::endl;
+    return ephemeris;
+}
+
+bool Ephemeris::build(const std::string& path, double startJulianDate, double endJulianDate) {
+    FileHeader header = {};
+    std::memcpy(header.magic, "SEPH", 4);
+    header.version = VERSION;
+    header.bodyCount = KeplerianElements::BODY_COUNT;
+    header.coefficientCount = COEFFICIENTS;
+    header.startJulianDate = startJulianDate;
+    header.endJulianDate = endJulianDate;
+
+    BodyRecord bodies[KeplerianElements::BODY_COUNT] = {};
+    uint64_t offset = sizeof(FileHeader) + sizeof(bodies);
+    for (int i = 0; i < KeplerianElements::BODY_COUNT; i++) {
+        bodies[i].segmentDays = SEGMENT_DAYS[i];
+        bodies[i].segmentCount = uint32_t(std::ceil((endJulianDate - startJulianDate) / SEGMENT_DAYS[i]));
+        bodies[i].offset = offset;
+        offset += uint64_t(bodies[i].segmentCount) * 3 * COEFFICIENTS * sizeof(double);
+    }
+
+    // Write to a temporary file and rename, so a running instance never maps a half-written cache
+    std::string temporary = path + ".tmp";
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write ephemeris cache: " << temporary << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bodies), sizeof(bodies));
+
+    std::vector<double> coefficients;
+    for (int i = 0; i < KeplerianElements::BODY_COUNT; i++) {
+        coefficients.resize(size_t(bodies[i].segmentCount) * 3 * COEFFICIENTS);
+        for (uint32_t s = 0; s < bodies[i].segmentCount; s++) {
+            fitSegment(KeplerianElements::Body(i), startJulianDate + s * bodies[i].segmentDays, bodies[i].segmentDays,
+                       &coefficients[size_t(s) * 3 * COEFFICIENTS]);
+        }
+        file.write(reinterpret_cast<const char*>(coefficients.data()), coefficients.size() * sizeof(double));
+    }
+
+    file.close();
+    if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to write ephemeris cache: " << path << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+glm::dvec3 Ephemeris::position(KeplerianElements::Body body, double julianDate) const {
+    const BodyRecord& record = reinterpret_cast<const BodyRecord*>(data + sizeof(FileHeader))[body];
+
+    double t = (std::clamp(julianDate, startJulianDate, endJulianDate) - startJulianDate) / record.segmentDays;
+    uint32_t segment = std::min(uint32_t(t), record.segmentCount - 1);
+    double local = 2.0 * (t - segment) - 1.0; // [-1, 1] within the segment
+
+    const double* c = reinterpret_cast<const double*>(data + record.offset) + size_t(segment) * 3 * COEFFICIENTS;
+    return glm::dvec3(clenshaw(c, local), clenshaw(c + COEFFICIENTS, local), clenshaw(c + 2 * COEFFICIENTS, local));
+}
+
+void Ephemeris::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+        data = nullptr;
+        size = 0;
+    }
+}
+
+double Ephemeris::julianDate(int year, int month, int day) {
+    // Fliegel & Van Flandern day number, minus half a day for 0h
+    int a = (14 - month) / 12;
+    int y = year + 4800 - a;
+    int m = month + 12 * a - 3;
+    long dayNumber = day + (153 * m + 2) / 5 + 365L * y + y / 4 - y / 100 + y / 400 - 32045;
+    return double(dayNumber) - 0.5;
+}
+
+bool Ephemeris::parseDate(const std::string& text, double& julianDate) {
+    int year, month, day;
+    char trailing;
+    if (std::sscanf(text.c_str(), "%d-%d-%d%c", &year, &month, &day, &trailing) != 3 || month < 1 || month > 12) {
+        return false;
+    }
+    // Gregorian month lengths, so 2024-02-31 is rejected instead of rolling over into March
+    static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    int monthLength = DAYS_IN_MONTH[month - 1] + (month == 2 && leapYear ? 1 : 0);
+    if (day < 1 || day > monthLength) {
+        return false;
+    }
+    julianDate = Ephemeris::julianDate(year, month, day);
+    return true;
+}
+
+std::string Ephemeris::calendarDate(double julianDate) {
+    // Inverse of julianDate() for the day containing the given date
+    long l = long(std::floor(julianDate + 0.5)) + 68569;
+    long n = 4 * l / 146097;
+    l = l - (146097 * n + 3) / 4;
+    long i = 4000 * (l + 1) / 1461001;
+    l = l - 1461 * i / 4 + 31;
+    long j = 80 * l / 2447;
+    long day = l - 2447 * j / 80;
+    l = j / 11;
+    long month = j + 2 - 12 * l;
+    long year = 100 * (n - 49) + i + l;
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", int(year), int(month), int(day));
+    return text;
+}
+
+double Ephemeris::currentJulianDate() {
+    return 2440587.5 + double(std::time(nullptr)) / 86400.0; // Unix epoch is JD 2440587.5
+}
+
+void OrbitScale::addKnot(double au, double sceneRadius) {
+    knots.insert(std::upper_bound(knots.begin(), knots.end(), std::make_pair(au, sceneRadius)),
+                 std::make_pair(au, sceneRadius));
+}
+
+double OrbitScale::sceneDistance(double au) const {
+    if (knots.empty()) {
+        return au;
+    }
+
+    // Through the origin below the first knot, extrapolate the last slope beyond the final one
+    double previousAU = 0.0, previousScene = 0.0;
+    for (size_t i = 0; i < knots.size(); i++) {
+        if (au <= knots[i].first || i + 1 == knots.size()) {
+            double slope = (knots[i].second - previousScene) / (knots[i].first - previousAU);
+            return previousScene + (au - previousAU) * slope;
+        }
+        previousAU = knots[i].first;
+        previousScene = knots[i].second;
+    }
+    return au;
+}
+
+glm::dvec3 OrbitScale::toScene(const glm::dvec3& heliocentricAU) const {
+    double distance = glm::length(heliocentricAU);
+    if (distance <= 0.0) {
+        return glm::dvec3(0.0);
+    }
+    glm::dvec3 scaled = heliocentricAU * (sceneDistance(distance) / distance);
+    return glm::dvec3(scaled.x, scaled.z, -scaled.y);
+}
@@ -0,0 +1,91 @@
+#include "include/physics/KeplerianElements.hpp"
+#include <cmath>
+
+namespace {
+// Elements at J2000 and their rates per Julian century:
+// a (AU), e, I (deg), L mean longitude (deg), longitude of perihelion (deg), longitude of ascending node (deg)
+struct Elements {
+    double a, e, inclination, meanLongitude, perihelion, node;
+    double aRate, eRate, inclinationRate, meanLongitudeRate, perihelionRate, nodeRate;
+};
+
+const Elements PLANETS[KeplerianElements::Moon] = {
+    {0.38709927, 0.20563593, 7.00497902, 252.25032350, 77.45779628, 48.33076593,
+     0.00000037, 0.00001906, -0.00594749, 149472.67411175, 0.16047689, -0.12534081},
+    {0.72333566, 0.00677672, 3.39467605, 181.97909950, 131.60246718, 76.67984255,
+     0.00000390, -0.00004107, -0.00078890, 58517.81538729, 0.00268329, -0.27769418},
+    // Earth-Moon barycenter
+    {1.00000261, 0.01671123, -0.00001531, 100.46457166, 102.93768193, 0.0,
+     0.00000562, -0.00004392, -0.01294668, 35999.37244981, 0.32327364, 0.0},
+    {1.52371034, 0.09339410, 1.84969142, -4.55343205, -23.94362959, 49.55953891,
+     0.00001847, 0.00007882, -0.00813131, 19140.30268499, 0.44441088, -0.29257343},
+    {5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983, 100.47390909,
+     -0.00011607, -0.00013253, -0.00183714, 3034.74612775, 0.21252668, 0.20469106},
+    {9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831, 113.66242448,
+     -0.00125060, -0.00050991, 0.00193609, 1222.49362201, -0.41897216, -0.28867794},
+    {19.18916464, 0.04725744, 0.77263783, 313.23810451, 170.95427630, 74.01692503,
+     -0.00196176, -0.00004397, -0.00242939, 428.48202785, 0.40805281, 0.04240589},
+    {30.06992276, 0.00859048, 1.77004347, -55.12002969, 44.96476227, 131.78422574,
+     0.00026291, 0.00005105, 0.00035372, 218.45945325, -0.32241464, -0.00508664},
+};
+
+const double MOON_SEMI_MAJOR_AXIS = 384400.0 / 149597870.7; // AU
+
+double radiansOf(double degrees) {
+    return degrees * M_PI / 180.0;
+}
+
+// Newton iterations on E - e sin E = M (radians)
+double solveKepler(double meanAnomaly, double e) {
+    double E = meanAnomaly + e * std::sin(meanAnomaly);
+    for (int i = 0; i < 8; i++) {
+        double delta = (E - e * std::sin(E) - meanAnomaly) / (1.0 - e * std::cos(E));
+        E -= delta;
+        if (std::abs(delta) < 1e-14) {
+            break;
+        }
+    }
+    return E;
+}
+
+// Orbit plane to ecliptic: argument of perihelion, inclination, node (all radians)
+glm::dvec3 orbitToEcliptic(double a, double e, double meanAnomaly, double periapsis, double inclination, double node) {
+    double E = solveKepler(std::remainder(meanAnomaly, 2.0 * M_PI), e);
+    double x = a * (std::cos(E) - e);
+    double y = a * std::sqrt(1.0 - e * e) * std::sin(E);
+
+    double cw = std::cos(periapsis), sw = std::sin(periapsis);
+    double ci = std::cos(inclination), si = std::sin(inclination);
+    double cn = std::cos(node), sn = std::sin(node);
+    return glm::dvec3((cw * cn - sw * sn * ci) * x + (-sw * cn - cw * sn * ci) * y,
+                      (cw * sn + sw * cn * ci) * x + (-sw * sn + cw * cn * ci) * y,
+                      (sw * si) * x + (cw * si) * y);
+}
+}
+
+glm::dvec3 KeplerianElements::position(Body body, double julianDate) {
+    if (body == Moon) {
+        // Mean elements of date, d = days since 1999 Dec 31.0
+        double d = julianDate - 2451543.5;
+        double node = radiansOf(125.1228 - 0.0529538083 * d);
+        double periapsis = radiansOf(318.0634 + 0.1643573223 * d);
+        double meanAnomaly = radiansOf(115.3654 + 13.0649929509 * d);
+        return orbitToEcliptic(MOON_SEMI_MAJOR_AXIS, 0.054900, meanAnomaly, periapsis, radiansOf(5.1454), node);
+    }
+
+    const Elements& el = PLANETS[body];
+    double T = (julianDate - J2000) / 36525.0;
+    double a = el.a + el.aRate * T;
+    double e = el.e + el.eRate * T;
+    double inclination = radiansOf(el.inclination + el.inclinationRate * T);
+    double meanLongitude = el.meanLongitude + el.meanLongitudeRate * T;
+    double perihelion = el.perihelion + el.perihelionRate * T;
+    double node = el.node + el.nodeRate * T;
+
+    return orbitToEcliptic(a, e, radiansOf(meanLongitude - perihelion), radiansOf(perihelion - node), inclination,
+                           radiansOf(node));
+}
+
+double KeplerianElements::semiMajorAxis(Body body) {
+    return body == Moon ? MOON_SEMI_MAJOR_AXIS : PLANETS[body].a;
+}
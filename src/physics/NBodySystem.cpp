@@ -0,0 +1,74 @@
+#include "include/physics/NBodySystem.hpp"
+#include <cmath>
+
+size_t NBodySystem::add(const glm::dvec3& position, const glm::dvec3& velocity, double particleMass) {
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    vx.push_back(velocity.x);
+    vy.push_back(velocity.y);
+    vz.push_back(velocity.z);
+    ax.push_back(0.0);
+    ay.push_back(0.0);
+    az.push_back(0.0);
+    mass.push_back(particleMass);
+    accelerationsValid = false;
+    return x.size() - 1;
+}
+
+glm::dvec3 NBodySystem::position(size_t i) const {
+    return glm::dvec3(x[i], y[i], z[i]);
+}
+
+glm::dvec3 NBodySystem::velocity(size_t i) const {
+    return glm::dvec3(vx[i], vy[i], vz[i]);
+}
+
+void NBodySystem::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    vx.clear();
+    vy.clear();
+    vz.clear();
+    ax.clear();
+    ay.clear();
+    az.clear();
+    mass.clear();
+    accelerationsValid = false;
+}
+
+void NBodySystem::removeMomentum() {
+    double totalMass = 0.0;
+    double px = 0.0, py = 0.0, pz = 0.0;
+    for (size_t i = 0; i < size(); i++) {
+        totalMass += mass[i];
+        px += mass[i] * vx[i];
+        py += mass[i] * vy[i];
+        pz += mass[i] * vz[i];
+    }
+    if (totalMass <= 0.0) {
+        return;
+    }
+    for (size_t i = 0; i < size(); i++) {
+        vx[i] -= px / totalMass;
+        vy[i] -= py / totalMass;
+        vz[i] -= pz / totalMass;
+    }
+}
+
+double NBodySystem::totalEnergy() const {
+    double kinetic = 0.0;
+    double potential = 0.0;
+    double softening2 = softening * softening;
+    for (size_t i = 0; i < size(); i++) {
+        kinetic += 0.5 * mass[i] * (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+        for (size_t j = i + 1; j < size(); j++) {
+            double dx = x[j] - x[i];
+            double dy = y[j] - y[i];
+            double dz = z[j] - z[i];
+            potential -= gravitationalConstant * mass[i] * mass[j] / std::sqrt(dx * dx + dy * dy + dz * dz + softening2);
+        }
+    }
+    return kinetic + potential;
+}
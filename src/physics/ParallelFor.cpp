@@ -0,0 +1,102 @@
+#include "include/physics/ParallelFor.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Job {
+    void (*run)(void* context, size_t chunk);
+    void* context;
+    size_t chunkCount;
+    size_t nextChunk; // First chunk nobody has claimed yet
+    size_t pending;   // Chunks not finished yet
+};
+
+// One worker per hardware thread besides the caller's. Jobs live on their caller's stack; the caller does not
+// return before pending reaches zero, so workers never see a dead job.
+class WorkerPool {
+public:
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable jobFinished;
+    std::deque<Job*> jobs; // Jobs with unclaimed chunks, oldest first
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    WorkerPool() {
+        size_t count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        workers.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Takes the next chunk of job and drops the job from the queue once all of its chunks are taken (mutex held)
+    size_t claim(Job& job) {
+        size_t chunk = job.nextChunk++;
+        if (job.nextChunk == job.chunkCount) {
+            jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+        }
+        return chunk;
+    }
+
+    // Runs a claimed chunk without holding the mutex (mutex held before and after)
+    void execute(std::unique_lock<std::mutex>& lock, Job& job, size_t chunk) {
+        lock.unlock();
+        job.run(job.context, chunk);
+        lock.lock();
+        if (--job.pending == 0) {
+            jobFinished.notify_all();
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            workAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            Job& job = *jobs.front();
+            execute(lock, job, claim(job));
+        }
+    }
+};
+
+WorkerPool& workerPool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+} // namespace
+
+void runParallel(size_t chunkCount, void (*run)(void* context, size_t chunk), void* context) {
+    if (chunkCount == 0) {
+        return;
+    }
+    WorkerPool& pool = workerPool();
+    Job job = {run, context, chunkCount, 0, chunkCount};
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.jobs.push_back(&job);
+    pool.workAvailable.notify_all();
+
+    // Chunks no worker has picked up yet run here, so a caller that is itself a worker never waits on an idle queue
+    while (job.nextChunk < job.chunkCount) {
+        pool.execute(lock, job, pool.claim(job));
+    }
+    pool.jobFinished.wait(lock, [&job] { return job.pending == 0; });
+}
@@ -0,0 +1,125 @@
+#include "include/space_objects/AsteroidBelt.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+AsteroidBelt AsteroidBelt::create(unsigned int count,
+                                  float innerRadius,
+                                  float outerRadius,
+                                  float referenceRadius,
+                                  unsigned int seed) {
+    AsteroidBelt belt;
+    belt.count = count;
+    belt.capacity = count;
+    belt.referenceRadius = referenceRadius;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    // Rock shapes: unit icosahedron, squashed into an ellipsoid and with each corner pushed in or out
+    const float phi = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    const glm::vec3 icosahedron[ROCK_VERTICES] = {
+        {-1.0f, phi, 0.0f}, {1.0f, phi, 0.0f}, {-1.0f, -phi, 0.0f}, {1.0f, -phi, 0.0f},
+        {0.0f, -1.0f, phi}, {0.0f, 1.0f, phi}, {0.0f, -1.0f, -phi}, {0.0f, 1.0f, -phi},
+        {phi, 0.0f, -1.0f}, {phi, 0.0f, 1.0f}, {-phi, 0.0f, -1.0f}, {-phi, 0.0f, 1.0f}};
+    for (int variant = 0; variant < ROCK_VARIANTS; variant++) {
+        glm::vec3 axes(0.6f + 0.4f * uniform(rng), 0.6f + 0.4f * uniform(rng), 0.6f + 0.4f * uniform(rng));
+        for (int i = 0; i < ROCK_VERTICES; i++) {
+            float bump = 0.75f + 0.5f * uniform(rng);
+            belt.rockVertices[variant * ROCK_VERTICES + i] = glm::normalize(icosahedron[i]) * axes * bump;
+        }
+    }
+
+    // Orbital elements: mostly circular, mostly flat, sizes skewed toward small rocks
+    std::vector<Asteroid> asteroids(count);
+    for (Asteroid& asteroid : asteroids) {
+        asteroid.semiMajorAxis = innerRadius + (outerRadius - innerRadius) * uniform(rng);
+        asteroid.eccentricity = std::min(std::abs(normal(rng)) * 0.01f, 0.05f);
+        asteroid.inclination = std::min(std::abs(normal(rng)) * glm::radians(3.0f), glm::radians(12.0f));
+        asteroid.ascendingNode = glm::two_pi<float>() * uniform(rng);
+        asteroid.argumentOfPeriapsis = glm::two_pi<float>() * uniform(rng);
+        asteroid.meanAnomaly = glm::two_pi<float>() * uniform(rng);
+        asteroid.size = 0.006f + 0.03f * std::pow(uniform(rng), 4.0f);
+        asteroid.spinPhase = glm::two_pi<float>() * uniform(rng);
+    }
+    std::cout << "Asteroid belt: " << count << " asteroids, " << (count * sizeof(Asteroid)) / 1024 << " KB"
+              << std::endl;
+
+    belt.vao = GlVertexArray::create();
+    belt.instanceVbo = GlBuffer::create();
+
+    RenderState::bindVertexArray(belt.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, belt.instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, asteroids.size() * sizeof(Asteroid), asteroids.data(), GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, belt.instanceVbo, MemoryBudget::Instances, asteroids.size() * sizeof(Asteroid));
+
+    // Two vec4s per instance: (a, e, i, node) and (periapsis, mean anomaly, size, spin)
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Asteroid), (void*)offsetof(Asteroid, semiMajorAxis));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Asteroid), (void*)offsetof(Asteroid, argumentOfPeriapsis));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    return belt;
+}
+
+void AsteroidBelt::reserve(unsigned int newCapacity) {
+    count = 0;
+    capacity = newCapacity;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, size_t(capacity) * sizeof(Asteroid), nullptr, GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, instanceVbo, MemoryBudget::Instances, size_t(capacity) * sizeof(Asteroid));
+}
+
+void AsteroidBelt::append(const Asteroid* asteroids, unsigned int appendCount) {
+    appendCount = std::min(appendCount, capacity - count);
+    if (appendCount == 0) {
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferSubData(GL_ARRAY_BUFFER, size_t(count) * sizeof(Asteroid), size_t(appendCount) * sizeof(Asteroid), asteroids);
+    count += appendCount;
+}
+
+void AsteroidBelt::render(GLuint shader,
+                          const glm::mat4& viewMatrix,
+                          const glm::mat4& projectionMatrix,
+                          const glm::vec3& sunPosition,
+                          float orbitAngle,
+                          float collapse,
+                          const glm::vec3& collapseCenter) const {
+    if (count == 0) {
+        return;
+    }
+
+    RenderState::setCullFace(false);
+    RenderState::setBlend(false);
+    RenderState::setDepthTest(true);
+    RenderState::useProgram(shader);
+
+    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+    glUniform3fv(glGetUniformLocation(shader, "rockVertices"), ROCK_VARIANTS * ROCK_VERTICES, glm::value_ptr(rockVertices[0]));
+    glUniform3fv(glGetUniformLocation(shader, "sunPosition"), 1, glm::value_ptr(sunPosition));
+    glUniform1f(glGetUniformLocation(shader, "orbitAngle"), orbitAngle);
+    glUniform1f(glGetUniformLocation(shader, "referenceRadius"), referenceRadius);
+    int knotCount = std::min<int>(distanceKnots.size(), MAX_DISTANCE_KNOTS);
+    glUniform1i(glGetUniformLocation(shader, "distanceKnotCount"), knotCount);
+    if (knotCount > 0) {
+        glUniform2fv(glGetUniformLocation(shader, "distanceKnots"), knotCount, glm::value_ptr(distanceKnots[0]));
+    }
+    glUniform1f(glGetUniformLocation(shader, "collapse"), collapse);
+    glUniform3fv(glGetUniformLocation(shader, "collapseCenter"), 1, glm::value_ptr(collapseCenter));
+
+    RenderState::bindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, ROCK_DRAW_VERTICES, count);
+}
@@ -1,9 +1,19 @@
 #include "include/space_objects/CelestialBody.hpp"
+#include "include/utils/RenderState.hpp"
 #include "include/utils/SphereUtils.hpp"
+#include "include/utils/TextureCache.hpp"
 #include "include/utils/TextureUtils.hpp"
-#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 #include <vector>
 
+namespace {
+// Impostor quads are generated from gl_VertexID, so every body shares one empty VAO
+GLuint impostorVAO() {
+    static GlVertexArray vao = GlVertexArray::create();
+    return vao;
+}
+}
+
 CelestialBody CelestialBody::create(const char* texturePath,
                                    float scale,
                                    float orbitRadius,
@@ -11,14 +21,17 @@ CelestialBody CelestialBody::create(const char* texturePath,
                                    float rotationSpeed) {
     CelestialBody body;
     body.scale = glm::vec3(scale);
-    body.position = glm::vec3(0.0f);
+    body.position = glm::dvec3(0.0);
     body.orbitRadius = orbitRadius;
     body.orbitSpeed = orbitSpeed;
     body.rotationSpeed = rotationSpeed;
     body.rotationAngle = 0.0f;
+    body.transformNode = -1;
+    body.atmosphere = true;
 
-    body.vao = SphereUtils::createTexturedSphereVAO(40, 40, body.indexCount);
-    body.texture = TextureUtils::loadTexture(texturePath);
+    body.vao = SphereUtils::texturedSphereVAO(40, 40, body.indexCount);
+    body.texture = TextureCache::get(texturePath);
+    body.averageColor = TextureUtils::averageColor(body.texture);
 
     return body;
 }
@@ -26,29 +39,16 @@ CelestialBody CelestialBody::create(const char* texturePath,
 void CelestialBody::render(GLuint shader,
                            const glm::mat4& viewMatrix,
                            const glm::mat4& projectionMatrix,
+                           const glm::mat4& worldMatrix,
                            const glm::vec3& lightPos,
-                           const glm::vec3& viewPos,
-                           bool isSun,
-                           const std::vector<glm::vec3>& allPlanetPositions,
-                           const std::vector<float>& allPlanetRadii) const {
+                           const glm::vec3& viewPos) const {
     // Disable culling for celestial bodies to ensure correct appearance
-    glDisable(GL_CULL_FACE);
-    glUseProgram(shader);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    RenderState::setCullFace(false);
+    RenderState::setBlend(false);
+    RenderState::setDepthTest(true);
+    RenderState::useProgram(shader);
+    RenderState::bindTexture(GL_TEXTURE_2D, texture);
     glUniform1i(glGetUniformLocation(shader, "texture1"), 0);
-    glUniform1i(glGetUniformLocation(shader, "isSun"), isSun ? 1 : 0);
-
-    // Pass planet data for shadow calculations
-    if (!isSun && !allPlanetPositions.empty()) {
-        glUniform3fv(glGetUniformLocation(shader, "planetPositions"),
-                     allPlanetPositions.size(),
-                     &allPlanetPositions[0][0]);
-        glUniform1fv(glGetUniformLocation(shader, "planetRadii"), allPlanetRadii.size(), &allPlanetRadii[0]);
-        glUniform1i(glGetUniformLocation(shader, "numPlanets"), allPlanetPositions.size());
-    }
-
-    glm::mat4 worldMatrix = getWorldMatrix();
 
     glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
@@ -57,26 +57,53 @@ void CelestialBody::render(GLuint shader,
     glUniform3fv(glGetUniformLocation(shader, "lightPos"), 1, &lightPos[0]);
     glUniform3fv(glGetUniformLocation(shader, "viewPos"), 1, &viewPos[0]);
 
-    glBindVertexArray(vao);
+    RenderState::bindVertexArray(vao);
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+}
+
+void CelestialBody::renderImpostor(GLuint shader,
+                                   const glm::mat4& viewMatrix,
+                                   const glm::mat4& projectionMatrix,
+                                   const glm::mat4& worldMatrix,
+                                   const glm::vec3& lightPos,
+                                   const glm::vec3& viewPos) const {
+    RenderState::setCullFace(false);
+    RenderState::setBlend(false);
+    RenderState::setDepthTest(true);
+    RenderState::useProgram(shader);
+    RenderState::bindTexture(GL_TEXTURE_2D, texture);
+    glUniform1i(glGetUniformLocation(shader, "texture1"), 0);
 
-    // Re-enable culling after rendering celestial bodies
-    glEnable(GL_CULL_FACE);
+    // Rotation and scale split back out of the world matrix, so impostor UVs line up with the mesh
+    float radius = glm::length(glm::vec3(worldMatrix[0]));
+    glm::vec3 center = glm::vec3(worldMatrix[3]);
+    glm::mat3 bodyRotation = glm::mat3(glm::vec3(worldMatrix[0]) / radius,
+                                       glm::vec3(worldMatrix[1]) / glm::length(glm::vec3(worldMatrix[1])),
+                                       glm::vec3(worldMatrix[2]) / glm::length(glm::vec3(worldMatrix[2])));
+
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
+    glUniformMatrix3fv(glGetUniformLocation(shader, "bodyRotation"), 1, GL_FALSE, &bodyRotation[0][0]);
+    glUniform3fv(glGetUniformLocation(shader, "center"), 1, &center[0]);
+    glUniform1f(glGetUniformLocation(shader, "radius"), radius);
+
+    glUniform3fv(glGetUniformLocation(shader, "lightPos"), 1, &lightPos[0]);
+    glUniform3fv(glGetUniformLocation(shader, "viewPos"), 1, &viewPos[0]);
+
+    RenderState::bindVertexArray(impostorVAO());
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 }
 
-void CelestialBody::update(const glm::vec3& centerPosition, float baseAngle, float dt) {
-    rotationAngle += rotationSpeed * dt;
+void CelestialBody::update(const glm::dvec3& centerPosition, double baseAngle, float dt) {
+    spin(dt);
+    position = centerPosition + orbitOffset(baseAngle);
+}
 
-    float orbitAngle = baseAngle * orbitSpeed;
-    position = centerPosition + 
-               glm::vec3(orbitRadius * cos(glm::radians(orbitAngle)), 
-                        0.0f, 
-                        orbitRadius * sin(glm::radians(orbitAngle)));
+glm::dvec3 CelestialBody::orbitOffset(double baseAngle) const {
+    double orbitAngle = glm::radians(std::fmod(baseAngle * orbitSpeed, 360.0));
+    return glm::dvec3(orbitRadius * std::cos(orbitAngle), 0.0, orbitRadius * std::sin(orbitAngle));
 }
 
-glm::mat4 CelestialBody::getWorldMatrix() const {
-    return glm::translate(glm::mat4(1.0f), position) *
-           glm::rotate(glm::mat4(1.0f), glm::radians(rotationAngle), glm::vec3(0.0f, 1.0f, 0.0f)) *
-           glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)) * 
-           glm::scale(glm::mat4(1.0f), scale);
+void CelestialBody::spin(float dt) {
+    rotationAngle = std::fmod(rotationAngle + rotationSpeed * dt, 360.0f);
 }
@@ -1,9 +1,18 @@
 #include "include/space_objects/Comet.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
 #include <GLFW/glfw3.h>
+#include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cmath>
+
+namespace {
+// Largest change of orbit angle per substep (radians)
+const double MAX_ANGLE_STEP = 0.01;
+}
 
 Comet Comet::create(const char* texturePath,
-                    const glm::vec3& orbitCenter,
+                    const glm::dvec3& orbitCenter,
                     float semiMajorAxis,
                     float eccentricity) {
     Comet comet;
@@ -15,40 +24,61 @@ Comet Comet::create(const char* texturePath,
     comet.orbitCenter = orbitCenter;
     comet.semiMajorAxis = semiMajorAxis;
     comet.eccentricity = eccentricity;
-    comet.orbitAngle = 0.0f;
+    comet.orbitAngle = 0.0;
+    comet.meanMotion = 0.5; // Slow orbital speed
     comet.maxTrailPoints = 150; // Long, visible trail
     comet.lastTrailUpdate = 0.0f;
+    comet.trailAnchor = orbitCenter;
 
     // Set up trail rendering
-    glGenVertexArrays(1, &comet.trailVAO);
-    glGenBuffers(1, &comet.trailVBO);
+    comet.trailVAO = GlVertexArray::create();
+    comet.trailVBO = GlBuffer::create();
 
     return comet;
 }
 
-void Comet::update(float dt, const glm::vec3& sunPosition) {
-    // Update orbital position
-    orbitAngle += 0.5f * dt; // Slow orbital speed
+double Comet::angularRate(double angle) const {
+    // r^2 * dtheta/dt is constant, with r = a(1 - e^2) / (1 + e cos theta)
+    double e = eccentricity;
+    double k = 1.0 + e * std::cos(angle);
+    return meanMotion * k * k / std::pow(1.0 - e * e, 1.5);
+}
+
+double Comet::preferredStep() const {
+    return MAX_ANGLE_STEP / angularRate(orbitAngle);
+}
 
+void Comet::advance(double dt) {
+    double k1 = angularRate(orbitAngle);
+    double k2 = angularRate(orbitAngle + 0.5 * dt * k1);
+    double k3 = angularRate(orbitAngle + 0.5 * dt * k2);
+    double k4 = angularRate(orbitAngle + dt * k3);
+    orbitAngle += dt * (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+
+    // Keep the angle small so long time-lapses do not eat its precision
+    orbitAngle = std::fmod(orbitAngle, 2.0 * M_PI);
+}
+
+void Comet::update(float dt, const glm::dvec3& sunPosition) {
     // Calculate elliptical orbit position
-    float a = semiMajorAxis; // Semi-major axis
-    float e = eccentricity;  // Eccentricity
+    double a = semiMajorAxis; // Semi-major axis
+    double e = eccentricity;  // Eccentricity
 
     // Elliptical orbit math
-    float r = a * (1.0f - e * e) / (1.0f + e * cos(orbitAngle));
-    float x = r * cos(orbitAngle);
-    float z = r * sin(orbitAngle);
+    double r = a * (1.0 - e * e) / (1.0 + e * std::cos(orbitAngle));
+    double x = r * std::cos(orbitAngle);
+    double z = r * std::sin(orbitAngle);
 
-    body.position = orbitCenter + glm::vec3(x, 0.0f, z);
+    body.position = orbitCenter + glm::dvec3(x, 0.0, z);
 
     // Update rotation
-    body.rotationAngle += body.rotationSpeed * dt;
+    body.spin(dt);
 
     // Update trail
     updateTrail(glfwGetTime(), sunPosition);
 }
 
-void Comet::updateTrail(float currentTime, const glm::vec3& sunPosition) {
+void Comet::updateTrail(float currentTime, const glm::dvec3& sunPosition) {
     // Add new trail point every 0.1 seconds
     if (currentTime - lastTrailUpdate > 0.1f) {
         TrailPoint newPoint;
@@ -56,7 +86,7 @@ void Comet::updateTrail(float currentTime, const glm::vec3& sunPosition) {
         newPoint.age = 0.0f;
 
         // Brightness based on distance from sun (closer = brighter trail)
-        float distanceFromSun = glm::length(body.position - sunPosition);
+        float distanceFromSun = float(glm::length(body.position - sunPosition));
         newPoint.brightness = 1.0f / (1.0f + distanceFromSun * 0.1f);
 
         trail.insert(trail.begin(), newPoint);
@@ -79,27 +109,28 @@ void Comet::updateTrail(float currentTime, const glm::vec3& sunPosition) {
 
 void Comet::renderTrail(GLuint shader, 
                          const glm::mat4& viewMatrix, 
-                         const glm::mat4& projectionMatrix) const {
+                         const glm::mat4& projectionMatrix,
+                         const FloatingOrigin& origin) const {
     if (trail.size() < 2)
         return;
 
-    glUseProgram(shader);
-    glBindVertexArray(trailVAO);
+    RenderState::useProgram(shader);
+    RenderState::bindVertexArray(trailVAO);
 
     // Set matrices
-    glm::mat4 worldMatrix(1.0f); // Identity - trail points are in world space
+    // Trail vertices are stored relative to the anchor, which is placed relative to the camera
+    glm::mat4 worldMatrix = glm::translate(glm::mat4(1.0f), origin.toRender(trailAnchor));
     glUniformMatrix4fv(glGetUniformLocation(shader, "worldMatrix"), 1, GL_FALSE, &worldMatrix[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
 
     // Enable blending for trail transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::setDepthTest(true);
 
     // Draw trail as line strip
     glDrawArrays(GL_LINE_STRIP, 0, trail.size());
-
-    glDisable(GL_BLEND);
 }
 
 void Comet::updateTrailVBO() {
@@ -109,9 +140,10 @@ void Comet::updateTrailVBO() {
     std::vector<glm::vec3> vertices;
     std::vector<glm::vec3> colors;
 
-    // Create line segments for the trail
+    // Create line segments for the trail, relative to the newest point so they fit in float
+    trailAnchor = trail[0].position;
     for (size_t i = 0; i < trail.size(); ++i) {
-        vertices.push_back(trail[i].position);
+        vertices.push_back(glm::vec3(trail[i].position - trailAnchor));
 
         // Color fades from bright blue/white to dark blue based on age
         float fade = 1.0f - (trail[i].age / 10.0f); // Fade over 10 seconds
@@ -124,12 +156,14 @@ void Comet::updateTrailVBO() {
         colors.push_back(color);
     }
 
-    glBindVertexArray(trailVAO);
+    RenderState::bindVertexArray(trailVAO);
     glBindBuffer(GL_ARRAY_BUFFER, trailVBO);
     glBufferData(GL_ARRAY_BUFFER,
                  vertices.size() * sizeof(glm::vec3) + colors.size() * sizeof(glm::vec3),
                  nullptr,
                  GL_DYNAMIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, trailVBO, MemoryBudget::Geometry,
+                           vertices.size() * sizeof(glm::vec3) + colors.size() * sizeof(glm::vec3));
 
     // Upload vertices
     glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), &vertices[0]);
@@ -0,0 +1,420 @@
+#include "include/space_objects/SmallBodyCatalog.hpp"
+#include "include/physics/KeplerianElements.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+const char MAGIC[4] = {'S', 'S', 'B', 'C'};
+constexpr size_t PARSE_CHUNK = 1 << 20;  // Bytes of text per parallel work item
+constexpr double DEGREES = 3.14159265358979323846 / 180.0;
+
+// Columns read from the catalog, everything else is skipped without parsing
+enum Column { A, E, I, OM, W, MA, EPOCH, H, DIAMETER, Q, COLUMN_COUNT };
+const char* COLUMN_NAMES[COLUMN_COUNT] = {"a", "e", "i", "om", "w", "ma", "epoch", "H", "diameter", "q"};
+
+// First ',', '"' or '\n' in [p, end), or end. Sixteen bytes per step with SSE2 or NEON.
+const char* nextDelimiter(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i comma = _mm_set1_epi8(','), quote = _mm_set1_epi8('"'), newline = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, quote)),
+                                    _mm_cmpeq_epi8(bytes, newline));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t comma = vdupq_n_u8(','), quote = vdupq_n_u8('"'), newline = vdupq_n_u8('\n');
+    for (; end - p >= 16; p += 16) {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(bytes, comma), vceqq_u8(bytes, quote)), vceqq_u8(bytes, newline));
+        // No movemask on NEON: narrowing shift packs each byte's match into a nibble of a 64-bit word
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0) {
+            return p + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+    while (p < end && *p != ',' && *p != '"' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+// Decimal number with optional sign, fraction and exponent, surrounding blanks allowed; false for empty fields
+bool parseNumber(const char* p, const char* end, double& value) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        end--;
+    }
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+
+    double mantissa = 0.0;
+    int digits = 0, scale = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        mantissa = mantissa * 10.0 + (*p - '0');
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++, scale--) {
+            mantissa = mantissa * 10.0 + (*p - '0');
+        }
+    }
+    if (digits == 0) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        int exponent = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            exponent = std::min(exponent * 10 + (*p - '0'), 1000);
+        }
+        scale += negativeExponent ? -exponent : exponent;
+    }
+    if (p != end) {
+        return false;
+    }
+    value = (negative ? -mantissa : mantissa) * std::pow(10.0, scale);
+    return true;
+}
+
+// Splits one CSV row into fields, calling field(column, begin, end) with quotes removed. Returns the end of the row.
+template <typename Field>
+const char* splitRow(const char* p, const char* end, Field field) {
+    for (int column = 0;; column++) {
+        const char* begin = p;
+        const char* fieldEnd;
+        if (p < end && *p == '"') {
+            // Quoted field: "" is an escaped quote, separators inside do not count
+            begin = ++p;
+            while (true) {
+                p = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!p) {
+                    p = end;
+                    break;
+                }
+                if (p + 1 < end && p[1] == '"') {
+                    p += 2;
+                    continue;
+                }
+                break;
+            }
+            fieldEnd = p;
+            p = p < end ? p + 1 : end;
+            while (p < end && *p != ',' && *p != '\n') {
+                p++;
+            }
+        } else {
+            p = nextDelimiter(p, end);
+            while (p < end && *p == '"') { // Stray quote inside an unquoted field
+                p = nextDelimiter(p + 1, end);
+            }
+            fieldEnd = p;
+        }
+        field(column, begin, fieldEnd);
+        if (p >= end || *p == '\n') {
+            return p < end ? p + 1 : end;
+        }
+        p++; // Comma
+    }
+}
+
+// Orbital elements of one catalog row in the belt's instance layout, false when the orbit is unusable
+bool makeRecord(const double* values, const bool* present, uint64_t rowOffset, AsteroidBelt::Asteroid& record) {
+    for (Column column : {E, I, OM, W, MA}) {
+        if (!present[column]) {
+            return false;
+        }
+    }
+    double e = values[E];
+    if (e < 0.0 || e >= 1.0) {
+        return false; // Parabolic and hyperbolic orbits never come back
+    }
+    double a = present[A] ? values[A] : present[Q] ? values[Q] / (1.0 - e) : 0.0;
+    if (!(a > 0.0) || a > 1.0e5) {
+        return false;
+    }
+
+    // Mean anomaly moved from the catalog epoch to J2000, where the belt's clock starts
+    double meanAnomaly = values[MA];
+    if (present[EPOCH]) {
+        double degreesPerDay = 0.9856076686 / std::pow(a, 1.5);
+        meanAnomaly += degreesPerDay * (KeplerianElements::J2000 - values[EPOCH]);
+    }
+    meanAnomaly = std::fmod(meanAnomaly, 360.0);
+
+    // Diameter in km, estimated from absolute magnitude with a typical albedo of 0.14 when missing
+    double diameter = present[DIAMETER] ? values[DIAMETER] : present[H] ? 1329.0 / std::sqrt(0.14) * std::pow(10.0, -values[H] / 5.0) : 1.0;
+
+    // Spin phase hashed from the row's position in the file, so it is stable across rebuilds
+    uint64_t hash = (rowOffset + 1) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 29;
+
+    record.semiMajorAxis = float(a);
+    record.eccentricity = float(e);
+    record.inclination = float(values[I] * DEGREES);
+    record.ascendingNode = float(values[OM] * DEGREES);
+    record.argumentOfPeriapsis = float(values[W] * DEGREES);
+    record.meanAnomaly = float(meanAnomaly * DEGREES);
+    record.size = float(0.005 * (1.0 + std::log10(1.0 + std::max(diameter, 0.0))));
+    record.spinPhase = float((hash >> 40) * (6.283185307179586 / double(1 << 24)));
+    return true;
+}
+
+bool sourceInfo(const std::string& path, int64_t& time, uint64_t& size) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    time = int64_t(info.st_mtime);
+    size = uint64_t(info.st_size);
+    return true;
+}
+
+// Read-only mapping of a whole file, nullptr when it is missing or empty
+const unsigned char* mapFile(const std::string& path, size_t& size) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+    size = info.st_size;
+    return static_cast<const unsigned char*>(mapped);
+}
+
+// Maps the cache if it is intact and was built from the current catalog
+bool mapCache(SmallBodyCatalog& catalog) {
+    int64_t sourceTime = 0;
+    uint64_t sourceSize = 0;
+    bool haveSource = sourceInfo(catalog.sourcePath, sourceTime, sourceSize);
+
+    size_t size = 0;
+    const unsigned char* data = mapFile(catalog.cachePath, size);
+    if (!data) {
+        return false;
+    }
+    const SmallBodyCatalog::FileHeader* header = reinterpret_cast<const SmallBodyCatalog::FileHeader*>(data);
+    bool matches = size >= sizeof(SmallBodyCatalog::FileHeader) && std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                   header->version == SmallBodyCatalog::VERSION &&
+                   size == sizeof(SmallBodyCatalog::FileHeader) + header->count * sizeof(AsteroidBelt::Asteroid) &&
+                   (!haveSource || (header->sourceTime == sourceTime && header->sourceSize == sourceSize));
+    if (!matches) {
+        munmap(const_cast<unsigned char*>(data), size);
+        return false;
+    }
+    catalog.data = data;
+    catalog.size = size;
+    MemoryBudget::trackCpu(MemoryBudget::Caches, int64_t(size));
+    return true;
+}
+}
+
+SmallBodyCatalog SmallBodyCatalog::open(const std::string& sourcePath, const std::string& cachePath) {
+    SmallBodyCatalog catalog;
+    catalog.sourcePath = sourcePath;
+    catalog.cachePath = cachePath;
+    if (mapCache(catalog)) {
+        std::cout << "Small bodies: " << catalog.count() << " from " << cachePath << std::endl;
+        return catalog;
+    }
+
+    int64_t sourceTime;
+    uint64_t sourceSize;
+    if (!sourceInfo(sourcePath, sourceTime, sourceSize)) {
+        std::cerr << "Failed to open small-body catalog: " << sourcePath << std::endl;
+        return catalog;
+    }
+    std::cout << "Building small-body cache " << cachePath << " from " << sourcePath << " in the background" << std::endl;
+    catalog.ingest = std::async(std::launch::async, build, sourcePath, cachePath);
+    return catalog;
+}
+
+bool SmallBodyCatalog::build(const std::string& sourcePath, const std::string& cachePath) {
+    auto start = std::chrono::steady_clock::now();
+    size_t textSize = 0;
+    const unsigned char* mapped = mapFile(sourcePath, textSize);
+    if (!mapped) {
+        std::cerr << "Failed to open small-body catalog: " << sourcePath << std::endl;
+        return false;
+    }
+    madvise(const_cast<unsigned char*>(mapped), textSize, MADV_SEQUENTIAL);
+    const char* text = reinterpret_cast<const char*>(mapped);
+    const char* textEnd = text + textSize;
+
+    // Header row names the columns
+    int roles[256];
+    std::fill(std::begin(roles), std::end(roles), -1);
+    bool found[COLUMN_COUNT] = {};
+    const char* body = splitRow(text, textEnd, [&](int column, const char* begin, const char* end) {
+        std::string name(begin, end);
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t\r") + 1);
+        for (int c = 0; c < COLUMN_COUNT; c++) {
+            if (name == COLUMN_NAMES[c] && column < 256) {
+                roles[column] = c;
+                found[c] = true;
+            }
+        }
+    });
+    if (!found[E] || !found[I] || !found[OM] || !found[W] || !found[MA] || (!found[A] && !found[Q])) {
+        std::cerr << sourcePath << ": header needs a (or q), e, i, om, w and ma columns" << std::endl;
+        munmap(const_cast<unsigned char*>(mapped), textSize);
+        return false;
+    }
+
+    // Rows are split into fixed byte ranges, a row belongs to the range holding its first byte
+    size_t bodyBytes = textEnd - body;
+    size_t chunkCount = (bodyBytes + PARSE_CHUNK - 1) / PARSE_CHUNK;
+    std::vector<std::vector<Asteroid>> chunks(chunkCount);
+    std::vector<uint64_t> skippedRows(chunkCount, 0);
+    parallelFor(chunkCount, [&](size_t firstChunk, size_t lastChunk) {
+        for (size_t chunk = firstChunk; chunk < lastChunk; chunk++) {
+            const char* p = body + chunk * PARSE_CHUNK;
+            const char* rangeEnd = body + std::min(bodyBytes, (chunk + 1) * PARSE_CHUNK);
+            if (p != body && p[-1] != '\n') {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', textEnd - p));
+                p = newline ? newline + 1 : textEnd; // Rest of a row owned by the previous range
+            }
+
+            std::vector<Asteroid>& records = chunks[chunk];
+            records.reserve(PARSE_CHUNK / 96);
+            while (p < rangeEnd) {
+                const char* row = p;
+                double values[COLUMN_COUNT];
+                bool present[COLUMN_COUNT] = {};
+                bool blank = true;
+                p = splitRow(p, textEnd, [&](int column, const char* begin, const char* end) {
+                    blank = blank && (end == begin || (end - begin == 1 && *begin == '\r'));
+                    int role = column < 256 ? roles[column] : -1;
+                    if (role >= 0) {
+                        present[role] = parseNumber(begin, end, values[role]);
+                    }
+                });
+                if (blank) {
+                    continue;
+                }
+                Asteroid record;
+                if (makeRecord(values, present, uint64_t(row - text), record)) {
+                    records.push_back(record);
+                } else {
+                    skippedRows[chunk]++;
+                }
+            }
+        }
+    }, 1);
+    munmap(const_cast<unsigned char*>(mapped), textSize);
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    sourceInfo(sourcePath, header.sourceTime, header.sourceSize);
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        header.count += chunks[chunk].size();
+        header.skipped += skippedRows[chunk];
+    }
+
+    // Write to a temporary file and rename, so a running instance never maps a half-written cache
+    std::string temporary = cachePath + ".tmp";
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(cachePath).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write small-body cache: " << temporary << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const std::vector<Asteroid>& records : chunks) {
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Asteroid));
+    }
+    file.close();
+    if (!file || std::rename(temporary.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to write small-body cache: " << cachePath << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Small bodies: parsed " << header.count << " orbits (" << header.skipped << " rows skipped) from "
+              << textSize / (1024 * 1024) << " MB in " << seconds << " s" << std::endl;
+    return true;
+}
+
+std::string SmallBodyCatalog::defaultCachePath(const std::string& sourcePath) {
+    return "cache/" + std::filesystem::path(sourcePath).stem().string() + ".ssbc";
+}
+
+void SmallBodyCatalog::stream(AsteroidBelt& belt, unsigned int maxRecords) {
+    // Pick up a finished background build without waiting for it
+    if (ingest.valid() && ingest.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        if (ingest.get() && !mapCache(*this)) {
+            std::cerr << "Failed to map small-body cache: " << cachePath << std::endl;
+        }
+    }
+    if (!data || streamed == count()) {
+        return;
+    }
+
+    if (streamed == 0) {
+        belt.reserve(unsigned(std::min<uint64_t>(count(), 0xFFFFFFFFu)));
+    }
+    const Asteroid* records = reinterpret_cast<const Asteroid*>(data + sizeof(FileHeader));
+    unsigned int batch = unsigned(std::min<uint64_t>(maxRecords, count() - streamed));
+    belt.append(records + streamed, batch);
+    streamed += batch;
+}
+
+uint64_t SmallBodyCatalog::count() const {
+    return data ? reinterpret_cast<const FileHeader*>(data)->count : 0;
+}
+
+void SmallBodyCatalog::close() {
+    if (ingest.valid()) {
+        ingest.wait();
+    }
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+        MemoryBudget::trackCpu(MemoryBudget::Caches, -int64_t(size));
+        data = nullptr;
+        size = 0;
+    }
+}
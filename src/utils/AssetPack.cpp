@@ -0,0 +1,202 @@
+#include "include/utils/AssetPack.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char MAGIC[4] = {'S', 'P', 'A', 'K'};
+
+const unsigned char* packData = nullptr; // Mapped pack, nullptr when none is mounted
+size_t packSize = 0;
+
+const AssetPack::FileHeader& header() {
+    return *reinterpret_cast<const AssetPack::FileHeader*>(packData);
+}
+
+const AssetPack::Entry* entries() {
+    return reinterpret_cast<const AssetPack::Entry*>(packData + sizeof(AssetPack::FileHeader));
+}
+
+std::string_view entryName(const AssetPack::Entry& entry) {
+    const char* names = reinterpret_cast<const char*>(entries() + header().entryCount);
+    return std::string_view(names + entry.name, entry.nameLength);
+}
+
+// Names are stored normalized with forward slashes: "shaders/ui.vert.glsl"
+std::string key(const std::string& path) {
+    std::string name = std::filesystem::path(path).lexically_normal().generic_string();
+    return name.compare(0, 2, "./") == 0 ? name.substr(2) : name;
+}
+
+// Structural checks so a damaged pack cannot send reads outside the mapping
+bool validate(const unsigned char* data, size_t size) {
+    if (size < sizeof(AssetPack::FileHeader)) {
+        return false;
+    }
+    const AssetPack::FileHeader* fileHeader = reinterpret_cast<const AssetPack::FileHeader*>(data);
+    if (std::memcmp(fileHeader->magic, MAGIC, sizeof(MAGIC)) != 0 || fileHeader->version != AssetPack::VERSION) {
+        return false;
+    }
+    uint64_t tableEnd = sizeof(AssetPack::FileHeader) + uint64_t(fileHeader->entryCount) * sizeof(AssetPack::Entry) +
+                        fileHeader->nameBytes;
+    if (tableEnd > size) {
+        return false;
+    }
+    const AssetPack::Entry* table = reinterpret_cast<const AssetPack::Entry*>(fileHeader + 1);
+    for (uint32_t i = 0; i < fileHeader->entryCount; i++) {
+        if (uint64_t(table[i].name) + table[i].nameLength > fileHeader->nameBytes || table[i].offset < tableEnd ||
+            table[i].offset > size || table[i].size > size - table[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+bool AssetPack::mount(const std::string& packPath) {
+    unmount();
+    int fd = open(packPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Failed to map asset pack: " << packPath << std::endl;
+        return false;
+    }
+    if (!validate(static_cast<const unsigned char*>(mapped), info.st_size)) {
+        std::cerr << "Invalid asset pack, using loose files: " << packPath << std::endl;
+        munmap(mapped, info.st_size);
+        return false;
+    }
+
+    packData = static_cast<const unsigned char*>(mapped);
+    packSize = info.st_size;
+    MemoryBudget::trackCpu(MemoryBudget::Caches, int64_t(packSize));
+    std::cout << "Asset pack: " << header().entryCount << " assets from " << packPath << std::endl;
+    return true;
+}
+
+void AssetPack::unmount() {
+    if (packData) {
+        munmap(const_cast<unsigned char*>(packData), packSize);
+        MemoryBudget::trackCpu(MemoryBudget::Caches, -int64_t(packSize));
+        packData = nullptr;
+        packSize = 0;
+    }
+}
+
+bool AssetPack::mounted() {
+    return packData != nullptr;
+}
+
+bool AssetPack::find(const std::string& path, std::string_view& contents) {
+    if (!packData) {
+        return false;
+    }
+    std::string name = key(path);
+    const Entry* begin = entries();
+    const Entry* end = begin + header().entryCount;
+    const Entry* found = std::lower_bound(begin, end, name, [](const Entry& entry, const std::string& wanted) {
+        return entryName(entry) < std::string_view(wanted);
+    });
+    if (found == end || entryName(*found) != name) {
+        return false;
+    }
+    contents = std::string_view(reinterpret_cast<const char*>(packData + found->offset), found->size);
+    return true;
+}
+
+bool AssetPack::read(const std::string& path, std::string& contents) {
+    std::string_view packed;
+    if (find(path, packed)) {
+        contents.assign(packed.data(), packed.size());
+        return true;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool AssetPack::write(const std::string& packPath, std::vector<std::string> paths) {
+    for (std::string& path : paths) {
+        path = key(path);
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    // Index first: names, then every asset's aligned offset after the tables
+    FileHeader fileHeader = {};
+    std::memcpy(fileHeader.magic, MAGIC, sizeof(MAGIC));
+    fileHeader.version = VERSION;
+    fileHeader.entryCount = uint32_t(paths.size());
+    std::vector<Entry> table(paths.size());
+    std::string names;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(paths[i], error);
+        if (error) {
+            std::cerr << "Failed to read asset: " << paths[i] << std::endl;
+            return false;
+        }
+        table[i].name = uint32_t(names.size());
+        table[i].nameLength = uint32_t(paths[i].size());
+        table[i].size = size;
+        names += paths[i];
+    }
+    fileHeader.nameBytes = uint32_t(names.size());
+    uint64_t offset = sizeof(FileHeader) + table.size() * sizeof(Entry) + names.size();
+    for (Entry& entry : table) {
+        offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    // Write to a temporary file and rename, so a running instance never maps a half-written pack
+    std::string temporary = packPath + ".tmp";
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write asset pack: " << temporary << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Entry));
+    file.write(names.data(), names.size());
+    for (size_t i = 0; i < paths.size() && file; i++) {
+        std::ifstream asset(paths[i], std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(asset)), std::istreambuf_iterator<char>());
+        if (contents.size() != table[i].size) {
+            std::cerr << "Asset changed while packing: " << paths[i] << std::endl;
+            file.setstate(std::ios::failbit);
+            break;
+        }
+        std::string padding(table[i].offset - uint64_t(file.tellp()), '\0');
+        file.write(padding.data(), padding.size());
+        file.write(contents.data(), contents.size());
+    }
+
+    file.close();
+    if (!file || std::rename(temporary.c_str(), packPath.c_str()) != 0) {
+        std::cerr << "Failed to write asset pack: " << packPath << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,715 @@
+// Generated by tools/embed_shaders.cpp from shaders/, do not edit.
+#include "include/utils/EmbeddedShaders.hpp"
+
+namespace EmbeddedShaders {
+
+const Source SOURCES[] = {
+    {"shaders/asteroid.frag.glsl", R"glsl(#version 330 core
+in vec3 Normal;
+in vec3 FragPos;
+flat in vec3 RockColor;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+uniform vec3 sunPosition;
+
+void main() {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    vec3 normal = normalize(Normal);
+    vec3 lightDir = normalize(sunPosition - FragPos);
+
+    // Same day/night split as the planets: diffuse sunlight plus a dim ambient
+    float diff = max(dot(normal, lightDir), 0.0);
+    float ambient = 0.08;
+    FragColor = vec4((ambient + diff) * RockColor, 1.0);
+}
+)glsl"},
+    {"shaders/asteroid.vert.glsl", R"glsl(#version 330 core
+// Asteroid belt: orbit evaluated per vertex from static elements, no per-frame CPU work
+layout (location = 0) in vec4 aOrbit;        // Semi-major axis, eccentricity, inclination, ascending node
+layout (location = 1) in vec4 aOrientation;  // Argument of periapsis, mean anomaly at t = 0, size, spin phase
+
+#define ROCK_VARIANTS 4
+#define ROCK_VERTICES 12
+#define MAX_DISTANCE_KNOTS 16
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 rockVertices[ROCK_VARIANTS * ROCK_VERTICES];
+uniform vec3 sunPosition;
+uniform float orbitAngle;       // Simulation clock: Earth's orbital angle in radians
+uniform float referenceRadius;  // Earth's orbit radius, moves one radian per radian of orbitAngle
+uniform float collapse;         // Black hole effect, 0 = off, 1 = fully collapsed
+uniform vec3 collapseCenter;
+uniform vec2 distanceKnots[MAX_DISTANCE_KNOTS]; // Catalog belts: (AU, scene units), like OrbitScale
+uniform int distanceKnotCount;                  // 0 when the elements are already in scene units
+
+out vec3 Normal;
+out vec3 FragPos;
+flat out vec3 RockColor;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+// Icosahedron faces, expanded per vertex so each triangle gets a flat normal
+const int ROCK_INDICES[60] = int[60](
+    0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+    1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+    3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+    4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1);
+
+// Newton iterations on E - e sin E = M, converges in a few steps for belt eccentricities.
+// Comet-like orbits start from E = pi, which converges for any e < 1, and take more steps.
+float solveKepler(float meanAnomaly, float e) {
+    bool eccentric = e > 0.6;
+    float E = eccentric ? 3.14159265 : meanAnomaly + e * sin(meanAnomaly);
+    int iterations = eccentric ? 12 : 4;
+    for (int i = 0; i < iterations; i++) {
+        E -= (E - e * sin(E) - meanAnomaly) / (1.0 - e * cos(E));
+    }
+    return E;
+}
+
+// Piecewise linear AU -> scene distance, same as OrbitScale::sceneDistance
+float sceneDistance(float au) {
+    // Through the origin below the first knot, the last slope beyond the final one
+    vec2 previous = vec2(0.0);
+    for (int i = 0; i < distanceKnotCount; i++) {
+        vec2 knot = distanceKnots[i];
+        if (au <= knot.x || i + 1 == distanceKnotCount) {
+            return previous.y + (au - previous.x) * (knot.y - previous.y) / (knot.x - previous.x);
+        }
+        previous = knot;
+    }
+    return au;
+}
+
+void main() {
+    float a = aOrbit.x;
+    float e = aOrbit.y;
+    float inclination = aOrbit.z;
+    float node = aOrbit.w;
+    float periapsis = aOrientation.x;
+
+    // Kepler's third law relative to Earth: mean motion ~ a^-1.5
+    float meanMotion = pow(referenceRadius / a, 1.5);
+    float meanAnomaly = mod(aOrientation.y + orbitAngle * meanMotion, 6.28318531);
+    float E = solveKepler(meanAnomaly, e);
+
+    // Position in the orbital plane, sun at the focus
+    float x = a * (cos(E) - e);
+    float y = a * sqrt(1.0 - e * e) * sin(E);
+
+    // Rotate by periapsis, inclination and node into the reference plane
+    float cw = cos(periapsis), sw = sin(periapsis);
+    float ci = cos(inclination), si = sin(inclination);
+    float cn = cos(node), sn = sin(node);
+    vec3 orbital = vec3((cn * cw - sn * sw * ci) * x + (-cn * sw - sn * cw * ci) * y,
+                        (sw * si) * x + (cw * si) * y,
+                        (sn * cw + cn * sw * ci) * x + (-sn * sw + cn * cw * ci) * y);
+    // Reference plane is XZ and motion runs from +X toward +Z, same as CelestialBody::update
+
+    // Catalog elements are heliocentric ecliptic in AU: compress the distance and use the ephemeris frame,
+    // where ecliptic (x, y, z) is world (x, z, -y)
+    if (distanceKnotCount > 0) {
+        float r = length(orbital);
+        orbital *= sceneDistance(r) / max(r, 1e-6);
+        orbital.z = -orbital.z;
+    }
+
+    vec3 center = mix(sunPosition + orbital, collapseCenter, collapse);
+    float size = aOrientation.z * (1.0 - collapse);
+
+    // Rock shape and tumble
+    int base = (gl_InstanceID % ROCK_VARIANTS) * ROCK_VERTICES;
+    int triangle = gl_VertexID / 3 * 3;
+    vec3 v0 = rockVertices[base + ROCK_INDICES[triangle]];
+    vec3 v1 = rockVertices[base + ROCK_INDICES[triangle + 1]];
+    vec3 v2 = rockVertices[base + ROCK_INDICES[triangle + 2]];
+    vec3 corner = rockVertices[base + ROCK_INDICES[gl_VertexID]];
+
+    vec3 faceNormal = normalize(cross(v1 - v0, v2 - v0));
+    if (dot(faceNormal, v0 + v1 + v2) < 0.0) {
+        faceNormal = -faceNormal;
+    }
+
+    float spin = aOrientation.w + orbitAngle * 6.0;
+    float cs = cos(spin), ss = sin(spin);
+    mat3 tumble = mat3(cs, 0.0, -ss,
+                       0.0, 1.0, 0.0,
+                       ss, 0.0, cs);
+
+    Normal = tumble * faceNormal;
+    FragPos = center + tumble * corner * size;
+
+    // Grey to brown, seeded by the random spin phase
+    float tint = fract(aOrientation.w * 7.31);
+    RockColor = mix(vec3(0.42, 0.40, 0.38), vec3(0.55, 0.44, 0.33), tint);
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(FragPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
+)glsl"},
+    {"shaders/body_points.frag.glsl", R"glsl(#version 330 core
+in vec3 PointColor;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+void main() {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    // Round sprite with a soft gaussian core
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(d, d);
+    if (r2 > 1.0) {
+        discard;
+    }
+    FragColor = vec4(PointColor * exp(-4.0 * r2), 1.0);
+}
+)glsl"},
+    {"shaders/body_points.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec3 aPosition;  // Body center relative to the camera (floating origin)
+layout (location = 1) in vec3 aColor;     // Body hue, brightest channel = 1
+layout (location = 2) in float aLogFlux;  // ln of reflected light, 0 = a lit 1 pixel body at Earth's distance
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 PointColor;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+void main() {
+    // Same logarithmic compression as the starfield so dim bodies fade out instead of vanishing
+    float brightness = clamp(1.0 + aLogFlux * 0.15, 0.15, 1.0);
+    PointColor = aColor * brightness;
+    gl_PointSize = clamp(2.0 + aLogFlux * 0.3, 1.0, 2.5);
+
+    gl_Position = projection * view * vec4(aPosition, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
+)glsl"},
+    {"shaders/body_shading.glsl", R"glsl(// Surface lighting shared by the mesh and impostor body shaders, included after their inputs.
+// Compiled per ShaderCache feature set instead of branching on uniforms per fragment:
+// SUN         self-lit with a warm rim glow, no sunlight or shadows
+// SHADOWS     other bodies in SceneData block the sunlight (off in comparison mode)
+// ATMOSPHERE  rim glow tinted by the surface colors (off for bodies marked 'airless' in the scene)
+uniform vec3 lightPos;      // Sun's position
+uniform vec3 viewPos;       // Camera position
+
+#ifdef SHADOWS
+// Shadow casters, uploaded once per frame by SceneBuffer
+// 1023 bodies + header fills the 16 KB minimum uniform block size
+#define MAX_SCENE_BODIES 1023
+layout(std140) uniform SceneData {
+    int bodyCount;                      // Number of shadow casters
+    vec4 bodies[MAX_SCENE_BODIES];      // xyz = position, w = radius
+};
+
+bool isInShadow(vec3 fragPos) {
+    vec3 lightDir = normalize(lightPos - fragPos);
+    float distanceToLight = length(lightPos - fragPos);
+
+    // Check each planet for potential shadowing
+    for (int i = 0; i < bodyCount; i++) {
+        vec3 planetPosition = bodies[i].xyz;
+        vec3 planetToFragment = fragPos - planetPosition;
+        float planetRadius = bodies[i].w;
+
+        // Skip if this is our own planet
+        if (length(planetToFragment) < planetRadius * 1.1) continue;
+
+        // Calculate closest point on ray to planet center
+        float t = dot(lightDir, planetPosition - fragPos);
+        vec3 closestPoint = fragPos + lightDir * t;
+
+        // Check if closest point is between fragment and light
+        if (t > 0 && t < distanceToLight) {
+            float dist = length(closestPoint - planetPosition);
+            if (dist < planetRadius) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#endif
+
+#ifdef ATMOSPHERE
+// Planet type guessed from the dominant surface colors
+vec3 getAtmosphereColor(vec4 texColor) {
+    // Earth - blue atmosphere
+    if (texColor.b > 0.3 && texColor.g > 0.3) {
+        return vec3(0.3, 0.6, 1.0); // Light blue
+    }
+    // Mars - thin reddish atmosphere
+    else if (texColor.r > texColor.g && texColor.r > texColor.b) {
+        return vec3(1.0, 0.4, 0.2); // Orange-red
+    }
+    // Venus - thick yellowish atmosphere
+    else if (texColor.r > 0.6 && texColor.g > 0.6 && texColor.b < 0.3) {
+        return vec3(1.0, 0.8, 0.3); // Yellow-orange
+    }
+    // Gas giants - use dominant color with slight blue tint
+    else {
+        return mix(texColor.rgb, vec3(0.5, 0.7, 1.0), 0.3);
+    }
+}
+#endif
+
+// Lit color of a surface point; fragPos and normal in world axes relative to the camera
+vec4 shadeBody(vec4 texColor, vec3 fragPos, vec3 normal) {
+    normal = normalize(normal);
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+#ifdef SUN
+    // Sun is self-illuminating with slight glow
+    float rim = pow(1.0 - max(dot(normal, viewDir), 0.0), 2.0);
+    vec3 glowColor = vec3(1.0, 0.8, 0.4); // Warm sun glow
+    return texColor + vec4(glowColor * rim * 0.3, 0.0);
+#else
+    // Calculate diffuse lighting (day/night effect)
+    vec3 lightDir = normalize(lightPos - fragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+#ifdef SHADOWS
+    if (isInShadow(fragPos)) {
+        diff *= 0.1; // Reduce lighting significantly in shadowed areas
+    }
+#endif
+
+    // Ambient light (for slightly visible night side)
+    float ambientStrength = 0.1;
+    vec3 ambient = ambientStrength * vec3(1.0);
+    vec3 result = (ambient + diff) * texColor.rgb;
+
+#ifdef ATMOSPHERE
+    // Atmospheric rim lighting, stronger on the lit side
+    float rim = pow(1.0 - max(dot(normal, viewDir), 0.0), 3.0);
+    float glowStrength = 0.4 * (0.5 + 0.5 * diff);
+    result += getAtmosphereColor(texColor) * rim * glowStrength;
+#endif
+    return vec4(result, texColor.a);
+#endif
+}
+)glsl"},
+    {"shaders/impostor_sphere.frag.glsl", R"glsl(#version 330 core
+// Ray-traced sphere impostor: intersects the view ray with the body per pixel,
+// writes the true depth and derives normal and UV analytically (matches SphereUtils' UV layout)
+in vec3 ViewRay;
+flat in vec3 CenterView;
+
+out vec4 FragColor;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 center;        // Sphere center relative to the camera (floating origin)
+uniform float radius;       // Sphere radius
+uniform mat3 bodyRotation;  // Spin and flip from CelestialBody::getWorldMatrix, without scale
+
+uniform sampler2D texture1;
+
+#ifdef LOG_DEPTH
+uniform float logDepthCoefficient;
+#endif
+
+#include "body_shading.glsl"
+
+void main() {
+    // Ray from the eye (view-space origin) against the sphere
+    vec3 rayDir = normalize(ViewRay);
+    float b = dot(rayDir, CenterView);
+    float h = b * b - dot(CenterView, CenterView) + radius * radius;
+    if (h < 0.0) {
+        discard;
+    }
+    vec3 hitView = rayDir * (b - sqrt(h));
+
+    // True depth of the hit point instead of the quad's, in whichever depth mode is active
+    vec4 clipPos = projectionMatrix * vec4(hitView, 1.0);
+#if defined(LOG_DEPTH)
+    gl_FragDepth = log2(1.0 + clipPos.w) * logDepthCoefficient;
+#elif defined(REVERSED_Z)
+    gl_FragDepth = clipPos.z / clipPos.w; // glClipControl zero-to-one: NDC z is already window depth
+#else
+    gl_FragDepth = (clipPos.z / clipPos.w) * 0.5 + 0.5;
+#endif
+
+    // Back to world space: the inverse of the view rotation is its transpose
+    vec3 normal = transpose(mat3(viewMatrix)) * ((hitView - CenterView) / radius);
+    vec3 fragPos = center + normal * radius;
+
+    // Object-space direction gives the same UVs as the UV sphere mesh
+    vec3 objectDir = transpose(bodyRotation) * normal;
+    float u = atan(objectDir.z, objectDir.x) / 6.28318531;
+    float uWrapped = fract(u);          // Seam at u = 0
+    float uCentered = fract(u + 0.5);   // Seam at u = 0.5
+    float v = asin(clamp(objectDir.y, -1.0, 1.0)) / 3.14159265 + 0.5;
+    vec2 texCoord = vec2(uWrapped, v);
+
+    // Take derivatives from whichever parameterization has no seam here, so mip selection stays smooth
+    float dudx = abs(dFdx(uWrapped)) < abs(dFdx(uCentered)) ? dFdx(uWrapped) : dFdx(uCentered);
+    float dudy = abs(dFdy(uWrapped)) < abs(dFdy(uCentered)) ? dFdy(uWrapped) : dFdy(uCentered);
+    vec2 texCoordDx = vec2(dudx, dFdx(v));
+    vec2 texCoordDy = vec2(dudy, dFdy(v));
+
+    FragColor = shadeBody(textureGrad(texture1, texCoord, texCoordDx, texCoordDy), fragPos, normal);
+}
+)glsl"},
+    {"shaders/impostor_sphere.vert.glsl", R"glsl(#version 330 core
+// Camera-facing quad that covers a sphere's silhouette; the fragment shader ray-traces the sphere.
+// Drawn as a 4-vertex triangle strip with no vertex attributes.
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 center;   // Sphere center relative to the camera (floating origin)
+uniform float radius;  // Sphere radius
+
+out vec3 ViewRay;          // View-space point on the quad, i.e. the ray from the eye through this pixel
+flat out vec3 CenterView;  // Sphere center in view space
+
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1) * 2.0 - 1.0;
+
+    CenterView = (viewMatrix * vec4(center, 1.0)).xyz;
+    float distanceToCenter = length(CenterView);
+    vec3 axis = CenterView / distanceToCenter;
+
+    // Quad through the center, perpendicular to the view axis
+    vec3 helper = abs(axis.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    vec3 right = normalize(cross(axis, helper));
+    vec3 up = cross(right, axis);
+
+    // The silhouette cone has half-angle asin(r / d), its cross-section at the center is r * d / sqrt(d^2 - r^2)
+    float halfSize = radius * 10.0;
+    if (distanceToCenter > radius * 1.01) {
+        halfSize = radius * distanceToCenter / sqrt(distanceToCenter * distanceToCenter - radius * radius);
+    }
+
+    ViewRay = CenterView + (right * corner.x + up * corner.y) * halfSize;
+    gl_Position = projectionMatrix * vec4(ViewRay, 1.0);
+}
+)glsl"},
+    {"shaders/selection.frag.glsl", R"glsl(#version 330 core
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+uniform vec3 selectionColor;
+
+void main()
+{
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    FragColor = vec4(selectionColor, 1.0);
+}
+)glsl"},
+    {"shaders/selection.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+uniform mat4 worldMatrix;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+void main()
+{
+    gl_Position = projectionMatrix * viewMatrix * worldMatrix * vec4(aPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
+)glsl"},
+    {"shaders/shader.frag.glsl", R"glsl(#version 330 core
+in vec3 Normal;
+in vec2 TexCoords;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient;
+#endif
+
+uniform sampler2D texture1;
+uniform vec3 lightPos;  // Light position relative to the camera (floating origin)
+uniform vec3 viewPos;   // Camera position
+uniform vec3 selectionColor;  // Selection indicator color
+
+void main()
+{
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    // If selection color is provided, use it directly (for selection indicator)
+    if (selectionColor != vec3(0.0)) {
+        FragColor = vec4(selectionColor, 1.0);
+        return;
+    }
+
+    // Regular rendering for celestial bodies
+    // Ambient lighting
+    float ambientStrength = 0.2;
+    vec3 ambient = ambientStrength * vec3(1.0);
+    
+    // Diffuse lighting
+    vec3 lightDir = normalize(vec3(1.0, 1.0, 1.0));
+    vec3 norm = normalize(Normal);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * vec3(0.7); // Reduced diffuse intensity
+    
+    // Combine lighting
+    vec3 lighting = ambient + diffuse;
+    
+    // Get texture color and apply lighting
+    vec4 texColor = texture(texture1, TexCoords);
+    vec3 result = lighting * texColor.rgb;
+    
+    // Ensure we're not exceeding maximum brightness
+    result = min(result, vec3(1.0));
+    
+    FragColor = vec4(result, texColor.a);
+}
+)glsl"},
+    {"shaders/shader.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+uniform mat4 worldMatrix;
+uniform mat4 viewMatrix = mat4(1.0);
+uniform mat4 projectionMatrix = mat4(1.0);
+
+out vec3 Normal;
+out vec2 TexCoords;
+
+#ifdef LOG_DEPTH
+out float LogDepthW;
+#endif
+
+void main()
+{
+    Normal = mat3(transpose(inverse(worldMatrix))) * aNormal;
+    TexCoords = aTexCoords;
+    gl_Position = projectionMatrix * viewMatrix * worldMatrix * vec4(aPos, 1.0);
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
+)glsl"},
+    {"shaders/skybox_fragment.glsl", R"glsl(#version 330 core
+in vec3 TexCoords;
+out vec4 FragColor;
+
+uniform samplerCube skybox;
+
+void main()
+{
+    FragColor = texture(skybox, TexCoords);
+}
+)glsl"},
+    {"shaders/skybox_vertex.glsl", R"glsl(#version 330 core
+out vec3 TexCoords;
+
+uniform mat4 inverseViewProjection;
+
+void main()
+{
+    // Full-screen triangle from the vertex index: (-1,-1), (3,-1), (-1,3)
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+
+    // View ray through this corner of the far plane (affine across the screen, so interpolation is exact)
+    vec4 ray = inverseViewProjection * vec4(pos, 1.0, 1.0);
+    TexCoords = ray.xyz / ray.w;
+
+    // z = w puts the sky at depth 1.0, same as the old pos.xyww trick (reversed-Z: far is depth 0.0)
+#ifdef REVERSED_Z
+    gl_Position = vec4(pos, 0.0, 1.0);
+#else
+    gl_Position = vec4(pos, 1.0, 1.0);
+#endif
+}
+)glsl"},
+    {"shaders/starfield.frag.glsl", R"glsl(#version 330 core
+in vec3 StarColor;
+
+out vec4 FragColor;
+
+void main() {
+    // Round sprite with a soft gaussian core
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(d, d);
+    if (r2 > 1.0) {
+        discard;
+    }
+    FragColor = vec4(StarColor * exp(-4.0 * r2), 1.0);
+}
+)glsl"},
+    {"shaders/starfield.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec3 aDirection;   // Unit vector toward the star
+layout (location = 1) in float aMagnitude;  // (mag + 2) * 20
+layout (location = 2) in float aColorIndex; // (B-V + 0.5) * 100
+
+uniform mat4 view;        // Rotation only
+uniform mat4 projection;
+uniform float pointScale; // Sprite size multiplier for the current resolution
+
+out vec3 StarColor;
+
+// Rough B-V to RGB: hot blue-white stars through white to cool orange-red
+vec3 colorFromIndex(float bv) {
+    float t = clamp((bv + 0.4) / 2.4, 0.0, 1.0);
+    vec3 hot = vec3(0.62, 0.72, 1.0);
+    vec3 white = vec3(1.0, 0.97, 0.92);
+    vec3 cool = vec3(1.0, 0.62, 0.35);
+    return mix(mix(hot, white, smoothstep(0.0, 0.35, t)), cool, smoothstep(0.35, 1.0, t));
+}
+
+void main() {
+    float magnitude = aMagnitude / 20.0 - 2.0;
+    float colorIndex = aColorIndex / 100.0 - 0.5;
+
+    // Flux relative to the naked-eye limit (mag 6.5), compressed logarithmically for display
+    float logFlux = 0.4 * (6.5 - magnitude) * 2.302585;
+    float brightness = clamp(0.25 + logFlux * 0.12, 0.25, 1.0);
+
+    StarColor = colorFromIndex(colorIndex) * brightness;
+    gl_PointSize = pointScale * (1.0 + logFlux * 0.35);
+
+    // Same far-plane trick as the skybox: depth 1.0, hidden behind any planet
+    vec4 pos = projection * view * vec4(aDirection, 1.0);
+#ifdef REVERSED_Z
+    gl_Position = vec4(pos.xy, 0.0, pos.w);
+#else
+    gl_Position = pos.xyww;
+#endif
+}
+)glsl"},
+    {"shaders/textured_sphere.frag.glsl", R"glsl(#version 330 core
+in vec2 TexCoord;
+in vec3 FragPos;
+in vec3 Normal;
+
+out vec4 FragColor;
+
+#ifdef LOG_DEPTH
+in float LogDepthW;
+uniform float logDepthCoefficient; // 1 / log2(far + 1)
+#endif
+
+uniform sampler2D texture1;
+
+#include "body_shading.glsl"
+
+void main() {
+#ifdef LOG_DEPTH
+    gl_FragDepth = log2(LogDepthW) * logDepthCoefficient;
+#endif
+
+    FragColor = shadeBody(texture(texture1, TexCoord), FragPos, Normal);
+}
+)glsl"},
+    {"shaders/textured_sphere.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+uniform mat4 worldMatrix;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec2 TexCoord;
+out vec3 FragPos;  // Fragment position in world axes, relative to the camera
+out vec3 Normal;   // Normal in world space
+
+#ifdef LOG_DEPTH
+out float LogDepthW; // 1 + clip w, interpolated for per-fragment logarithmic depth
+#endif
+
+void main() {
+    vec4 worldPos = worldMatrix * vec4(aPos, 1.0);
+    FragPos = vec3(worldPos);
+    
+    // For a sphere, the normal is the same as the position (normalized)
+    Normal = normalize(mat3(worldMatrix) * aPos);
+    
+    TexCoord = aTexCoord;
+    gl_Position = projectionMatrix * viewMatrix * worldPos;
+#ifdef LOG_DEPTH
+    LogDepthW = 1.0 + gl_Position.w;
+#endif
+}
+)glsl"},
+    {"shaders/ui.frag.glsl", R"glsl(#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+in vec4 Color;
+
+uniform sampler2D atlas;
+uniform float alpha;
+
+void main() {
+    // Distance field: 0.5 on the glyph outline, antialiased over about one screen pixel at any text size
+    float distance = texture(atlas, TexCoord).r;
+    float width = max(fwidth(distance) * 0.75, 1e-4);
+    float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+    if (coverage <= 0.0) {
+        discard;
+    }
+    FragColor = vec4(Color.rgb, Color.a * coverage * alpha);
+}
+)glsl"},
+    {"shaders/ui.vert.glsl", R"glsl(#version 330 core
+layout (location = 0) in vec2 aPos;      // Pixels from the top-left of the text block, y down
+layout (location = 1) in vec2 aTexCoord; // Distance field atlas
+layout (location = 2) in vec4 aColor;
+
+out vec2 TexCoord;
+out vec4 Color;
+
+uniform mat4 projection;
+uniform vec2 origin; // Top-left of the block in window pixels, y up
+
+void main() {
+    gl_Position = projection * vec4(origin.x + aPos.x, origin.y - aPos.y, 0.0, 1.0);
+    TexCoord = aTexCoord;
+    Color = aColor;
+}
+)glsl"},
+};
+
+const size_t SOURCE_COUNT = sizeof(SOURCES) / sizeof(SOURCES[0]);
+
+}
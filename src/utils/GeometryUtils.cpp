@@ -1,8 +1,10 @@
 #include "include/utils/GeometryUtils.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
 
 namespace GeometryUtils {
 
-GLuint createVertexBufferObject() {
+VertexBuffers createVertexBufferObject() {
     glm::vec3 vertexArray[] = {
         // Front face (red)
         glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(1.0f, 0.0f, 0.0f),
@@ -59,14 +61,14 @@ GLuint createVertexBufferObject() {
         glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(1.0f, 1.0f, 0.0f)
     };
 
-    GLuint vertexArrayObject;
-    glGenVertexArrays(1, &vertexArrayObject);
-    glBindVertexArray(vertexArrayObject);
+    VertexBuffers cube;
+    cube.vao = GlVertexArray::create();
+    RenderState::bindVertexArray(cube.vao);
 
-    GLuint vertexBufferObject;
-    glGenBuffers(1, &vertexBufferObject);
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
+    cube.vbo = GlBuffer::create();
+    glBindBuffer(GL_ARRAY_BUFFER, cube.vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertexArray), vertexArray, GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, cube.vbo, MemoryBudget::Geometry, sizeof(vertexArray));
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)0);
     glEnableVertexAttribArray(0);
@@ -74,7 +76,7 @@ GLuint createVertexBufferObject() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)sizeof(glm::vec3));
     glEnableVertexAttribArray(1);
 
-    return vertexBufferObject;
+    return cube;
 }
 
 }
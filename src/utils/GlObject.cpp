@@ -0,0 +1,41 @@
+#include "include/utils/GlObject.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+
+namespace {
+bool contextAlive = true;
+}
+
+void deleteGlObject(GlKind kind, GLuint name) {
+    // After shutdown this runs from static destructors, where even the budget's own tables may be gone
+    if (!contextAlive) {
+        return;
+    }
+    MemoryBudget::releaseGpu(kind, name);
+    switch (kind) {
+    case GlKind::Buffer:
+        glDeleteBuffers(1, &name);
+        break;
+    case GlKind::Texture:
+        glDeleteTextures(1, &name);
+        RenderState::forgetTexture(name);
+        break;
+    case GlKind::VertexArray:
+        glDeleteVertexArrays(1, &name);
+        RenderState::forgetVertexArray(name);
+        break;
+    case GlKind::Renderbuffer:
+        glDeleteRenderbuffers(1, &name);
+        break;
+    case GlKind::Framebuffer:
+        glDeleteFramebuffers(1, &name);
+        break;
+    case GlKind::Query:
+        glDeleteQueries(1, &name);
+        break;
+    }
+}
+
+void markGlContextDestroyed() {
+    contextAlive = false;
+}
@@ -0,0 +1,60 @@
+#include "include/utils/GpuTimer.hpp"
+
+GpuTimer GpuTimer::create() {
+    GpuTimer timer;
+    bool available = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    for (int i = 0; i < LATENCY; i++) {
+        if (available) {
+            timer.queries[i] = GlQuery::create();
+        }
+        timer.pending[i] = false;
+    }
+    timer.next = 0;
+    timer.active = false;
+    timer.milliseconds = -1.0;
+    return timer;
+}
+
+bool GpuTimer::supported() const {
+    return queries[0] != 0;
+}
+
+void GpuTimer::begin() {
+    if (!supported()) {
+        return;
+    }
+    collect();
+    if (pending[next]) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, queries[next]);
+    active = true;
+}
+
+void GpuTimer::end() {
+    if (!active) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    pending[next] = true;
+    next = (next + 1) % LATENCY;
+    active = false;
+}
+
+void GpuTimer::collect() {
+    for (int offset = 0; offset < LATENCY; offset++) {
+        int i = (next + offset) % LATENCY;
+        if (!pending[i]) {
+            continue;
+        }
+        GLint available = 0;
+        glGetQueryObjectiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &nanoseconds);
+        milliseconds = double(nanoseconds) * 1e-6;
+        pending[i] = false;
+    }
+}
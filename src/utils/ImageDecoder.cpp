@@ -0,0 +1,171 @@
+#include "include/utils/ImageDecoder.hpp"
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+// stb_image only takes its NEON paths when asked; SSE2 it detects by itself
+#if defined(__ARM_NEON)
+#define STBI_NEON
+#endif
+#define STB_IMAGE_IMPLEMENTATION
+#include "include/stb_image.h"
+
+#if defined(SOLARSCOPE_TURBOJPEG)
+#include <turbojpeg.h>
+#endif
+#if defined(SOLARSCOPE_SPNG)
+#include <spng.h>
+#endif
+
+namespace {
+thread_local const char* lastFailure = "";
+
+bool acceptsAnything(const unsigned char*, size_t) {
+    return true;
+}
+
+unsigned char* decodeStb(const unsigned char* data, size_t size, int* width, int* height, int* channels) {
+    if (size > size_t(INT_MAX)) {
+        lastFailure = "image too large";
+        return nullptr;
+    }
+    unsigned char* pixels = stbi_load_from_memory(data, int(size), width, height, channels, 0);
+    if (!pixels) {
+        lastFailure = stbi_failure_reason();
+    }
+    return pixels;
+}
+
+#if defined(SOLARSCOPE_TURBOJPEG)
+bool isJpeg(const unsigned char* data, size_t size) {
+    return size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+// Decompressor for the current thread, created on its first JPEG and destroyed when the thread exits
+struct TurboJpegHandle {
+    tjhandle handle = tjInitDecompress();
+    ~TurboJpegHandle() {
+        if (handle) {
+            tjDestroy(handle);
+        }
+    }
+};
+
+unsigned char* decodeTurboJpeg(const unsigned char* data, size_t size, int* width, int* height, int* channels) {
+    // One handle per thread: TurboJPEG handles are not shareable, and creating one per image costs more than
+    // decoding a small image
+    thread_local TurboJpegHandle decompressor;
+    tjhandle handle = decompressor.handle;
+    int subsampling = 0, colorspace = 0;
+    if (!handle || tjDecompressHeader3(handle, data, (unsigned long)size, width, height, &subsampling, &colorspace) != 0) {
+        lastFailure = handle ? tjGetErrorStr2(handle) : "cannot create a TurboJPEG decompressor";
+        return nullptr;
+    }
+    // Always RGB, like the textures the renderer uploads
+    unsigned char* pixels = static_cast<unsigned char*>(std::malloc(size_t(*width) * *height * 3));
+    if (!pixels || tjDecompress2(handle, data, (unsigned long)size, pixels, *width, 0, *height, TJPF_RGB, 0) != 0) {
+        lastFailure = pixels ? tjGetErrorStr2(handle) : "out of memory";
+        std::free(pixels);
+        return nullptr;
+    }
+    *channels = 3;
+    return pixels;
+}
+#endif
+
+#if defined(SOLARSCOPE_SPNG)
+bool isPng(const unsigned char* data, size_t size) {
+    static const unsigned char SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    return size >= 8 && std::memcmp(data, SIGNATURE, 8) == 0;
+}
+
+unsigned char* decodeSpng(const unsigned char* data, size_t size, int* width, int* height, int* channels) {
+    spng_ctx* context = spng_ctx_new(0);
+    if (!context) {
+        lastFailure = "cannot create a libspng context";
+        return nullptr;
+    }
+    unsigned char* pixels = nullptr;
+    struct spng_ihdr header;
+    struct spng_trns transparency;
+    int error = spng_set_png_buffer(context, data, size);
+    if (!error) {
+        error = spng_get_ihdr(context, &header);
+    }
+    if (!error) {
+        // RGBA when the image has any alpha, RGB otherwise, like the textures the renderer uploads
+        bool alpha = header.color_type == SPNG_COLOR_TYPE_TRUECOLOR_ALPHA ||
+                     header.color_type == SPNG_COLOR_TYPE_GRAYSCALE_ALPHA ||
+                     spng_get_trns(context, &transparency) == 0;
+        int format = alpha ? SPNG_FMT_RGBA8 : SPNG_FMT_RGB8;
+        size_t bytes = 0;
+        error = spng_decoded_image_size(context, format, &bytes);
+        if (!error) {
+            pixels = static_cast<unsigned char*>(std::malloc(bytes));
+            error = pixels ? spng_decode_image(context, pixels, bytes, format, alpha ? SPNG_DECODE_TRNS : 0)
+                           : SPNG_EMEM;
+        }
+        if (!error) {
+            *width = int(header.width);
+            *height = int(header.height);
+            *channels = alpha ? 4 : 3;
+        }
+    }
+    if (error) {
+        lastFailure = spng_strerror(error);
+        std::free(pixels);
+        pixels = nullptr;
+    }
+    spng_ctx_free(context);
+    return pixels;
+}
+#endif
+
+std::vector<ImageDecoder>& decoders() {
+    static std::vector<ImageDecoder> list = {
+#if defined(SOLARSCOPE_TURBOJPEG)
+        {"libjpeg-turbo", isJpeg, decodeTurboJpeg},
+#endif
+#if defined(SOLARSCOPE_SPNG)
+        {"libspng", isPng, decodeSpng},
+#endif
+        {"stb_image", acceptsAnything, decodeStb},
+    };
+    return list;
+}
+}
+
+const std::vector<ImageDecoder>& ImageDecoder::all() {
+    return decoders();
+}
+
+void ImageDecoder::add(const ImageDecoder& decoder) {
+    decoders().insert(decoders().begin(), decoder);
+}
+
+unsigned char* ImageDecoder::decodeAny(const unsigned char* data, size_t size, int* width, int* height, int* channels,
+                                       const char** decoderName) {
+    if (!data) {
+        lastFailure = "cannot read the file";
+        return nullptr;
+    }
+    lastFailure = "no decoder accepts this format";
+    for (const ImageDecoder& decoder : decoders()) {
+        if (!decoder.accepts(data, size)) {
+            continue;
+        }
+        // A backend that rejects a file it claimed (e.g. an unusual JPEG) leaves it to the next one
+        unsigned char* pixels = decoder.decode(data, size, width, height, channels);
+        if (pixels) {
+            if (decoderName) {
+                *decoderName = decoder.name;
+            }
+            return pixels;
+        }
+    }
+    return nullptr;
+}
+
+const char* ImageDecoder::failureReason() {
+    return lastFailure ? lastFailure : "unknown error";
+}
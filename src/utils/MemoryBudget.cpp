@@ -0,0 +1,113 @@
+#include "include/utils/MemoryBudget.hpp"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+struct Allocation {
+    MemoryBudget::Category category;
+    size_t bytes;
+};
+
+const char* CATEGORY_NAMES[MemoryBudget::CATEGORY_COUNT] = {
+    "geometry", "textures", "instances", "uniforms", "framebuffers", "caches",
+};
+
+// GL objects by kind and name
+std::unordered_map<uint64_t, Allocation> allocations;
+size_t gpuByCategory[MemoryBudget::CATEGORY_COUNT] = {};
+int64_t cpuByCategory[MemoryBudget::CATEGORY_COUNT] = {};
+size_t gpuBudget = 0, cpuBudget = 0;
+bool gpuOver = false, cpuOver = false;
+
+uint64_t objectKey(GlKind kind, GLuint name) {
+    return (uint64_t(kind) << 32) | name;
+}
+
+double megabytes(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+// Warns when usage crosses the budget, and re-arms once it is back under
+void checkBudget(const char* what, size_t used, size_t budget, bool& over) {
+    if (budget == 0) {
+        return;
+    }
+    if (used > budget && !over) {
+        over = true;
+        std::cerr << "Warning: " << what << " memory " << megabytes(used) << " MB is over its " << megabytes(budget)
+                  << " MB budget" << std::endl;
+        MemoryBudget::report(std::cerr);
+    } else if (used <= budget) {
+        over = false;
+    }
+}
+}
+
+void MemoryBudget::trackGpu(GlKind kind, GLuint name, Category category, size_t bytes) {
+    Allocation& allocation = allocations[objectKey(kind, name)];
+    gpuByCategory[allocation.category] -= allocation.bytes;
+    allocation = {category, bytes};
+    gpuByCategory[category] += bytes;
+    checkBudget("GPU", gpuBytes(), gpuBudget, gpuOver);
+}
+
+void MemoryBudget::releaseGpu(GlKind kind, GLuint name) {
+    auto found = allocations.find(objectKey(kind, name));
+    if (found != allocations.end()) {
+        gpuByCategory[found->second.category] -= found->second.bytes;
+        allocations.erase(found);
+        checkBudget("GPU", gpuBytes(), gpuBudget, gpuOver);
+    }
+}
+
+void MemoryBudget::trackCpu(Category category, int64_t bytes) {
+    cpuByCategory[category] += bytes;
+    checkBudget("CPU", cpuBytes(), cpuBudget, cpuOver);
+}
+
+void MemoryBudget::setBudgets(size_t gpuBytesBudget, size_t cpuBytesBudget) {
+    gpuBudget = gpuBytesBudget;
+    cpuBudget = cpuBytesBudget;
+    gpuOver = cpuOver = false;
+    checkBudget("GPU", gpuBytes(), gpuBudget, gpuOver);
+    checkBudget("CPU", cpuBytes(), cpuBudget, cpuOver);
+}
+
+size_t MemoryBudget::gpuBytes() {
+    size_t total = 0;
+    for (size_t bytes : gpuByCategory) {
+        total += bytes;
+    }
+    return total;
+}
+
+size_t MemoryBudget::cpuBytes() {
+    int64_t total = 0;
+    for (int64_t bytes : cpuByCategory) {
+        total += bytes;
+    }
+    return size_t(std::max<int64_t>(total, 0));
+}
+
+const char* MemoryBudget::categoryName(Category category) {
+    return CATEGORY_NAMES[category];
+}
+
+void MemoryBudget::report(std::ostream& out) {
+    out << "Memory: GPU " << megabytes(gpuBytes()) << " MB";
+    if (gpuBudget > 0) {
+        out << " of " << megabytes(gpuBudget) << " MB";
+    }
+    out << " in " << allocations.size() << " objects, CPU " << megabytes(cpuBytes()) << " MB";
+    if (cpuBudget > 0) {
+        out << " of " << megabytes(cpuBudget) << " MB";
+    }
+    out << std::endl;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        if (gpuByCategory[i] > 0 || cpuByCategory[i] > 0) {
+            out << "  " << CATEGORY_NAMES[i] << ": GPU " << megabytes(gpuByCategory[i]) << " MB, CPU "
+                << megabytes(double(cpuByCategory[i])) << " MB" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#include "include/utils/RenderState.hpp"
+#include <iostream>
+
+namespace {
+// Sentinel for "unknown", so the first call after startup or invalidate() always reaches the driver
+const GLuint UNKNOWN_NAME = 0xFFFFFFFFu;
+const GLenum UNKNOWN_ENUM = 0xFFFFFFFFu;
+
+enum class Toggle { Unknown, Off, On };
+
+struct CachedState {
+    GLuint program = UNKNOWN_NAME;
+    GLuint vao = UNKNOWN_NAME;
+    GLuint activeUnit = UNKNOWN_NAME;
+    GLenum textureTargets[RenderState::MAX_TEXTURE_UNITS];
+    GLuint textures[RenderState::MAX_TEXTURE_UNITS];
+    Toggle blend = Toggle::Unknown;
+    GLenum blendSrc = UNKNOWN_ENUM;
+    GLenum blendDst = UNKNOWN_ENUM;
+    Toggle cullFace = Toggle::Unknown;
+    Toggle depthTest = Toggle::Unknown;
+    GLenum depthFunc = UNKNOWN_ENUM;
+    Toggle depthMask = Toggle::Unknown;
+    GLenum polygonMode = UNKNOWN_ENUM;
+    Toggle programPointSize = Toggle::Unknown;
+
+    CachedState() {
+        for (int i = 0; i < RenderState::MAX_TEXTURE_UNITS; i++) {
+            textureTargets[i] = UNKNOWN_ENUM;
+            textures[i] = UNKNOWN_NAME;
+        }
+    }
+};
+
+CachedState state;
+RenderState::Counters counters = {0, 0};
+bool reversedDepth = false; // Not part of CachedState, invalidate() must not reset it
+
+GLenum reversedDepthFunc(GLenum func) {
+    switch (func) {
+    case GL_LESS: return GL_GREATER;
+    case GL_LEQUAL: return GL_GEQUAL;
+    case GL_GREATER: return GL_LESS;
+    case GL_GEQUAL: return GL_LEQUAL;
+    default: return func;
+    }
+}
+
+// Returns true if the call must be issued, and records the new value
+template <typename T>
+bool changed(T& cached, T value) {
+    if (cached == value) {
+        counters.skipped++;
+        return false;
+    }
+    cached = value;
+    counters.issued++;
+    return true;
+}
+
+void setCapability(Toggle& cached, GLenum capability, bool enabled) {
+    if (changed(cached, enabled ? Toggle::On : Toggle::Off)) {
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+    }
+}
+
+void GLAPIENTRY debugMessageCallback(GLenum /*source*/,
+                                     GLenum type,
+                                     GLuint id,
+                                     GLenum severity,
+                                     GLsizei /*length*/,
+                                     const GLchar* message,
+                                     const void* /*userParam*/) {
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION) {
+        return;
+    }
+    std::cerr << "OpenGL " << (type == GL_DEBUG_TYPE_ERROR ? "error" : "debug message") << " (id " << id
+              << "): " << message << std::endl;
+}
+}
+
+void RenderState::useProgram(GLuint program) {
+    if (changed(state.program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void RenderState::bindVertexArray(GLuint vao) {
+    if (changed(state.vao, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void RenderState::bindTexture(GLenum target, GLuint texture, GLuint unit) {
+    if (unit >= MAX_TEXTURE_UNITS) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        state.activeUnit = UNKNOWN_NAME;
+        counters.issued += 2;
+        return;
+    }
+
+    if (state.textures[unit] == texture && state.textureTargets[unit] == target) {
+        counters.skipped++;
+        return;
+    }
+
+    if (changed(state.activeUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    glBindTexture(target, texture);
+    state.textureTargets[unit] = target;
+    state.textures[unit] = texture;
+    counters.issued++;
+}
+
+void RenderState::setBlend(bool enabled) {
+    setCapability(state.blend, GL_BLEND, enabled);
+}
+
+void RenderState::setBlendFunc(GLenum srcFactor, GLenum dstFactor) {
+    if (state.blendSrc == srcFactor && state.blendDst == dstFactor) {
+        counters.skipped++;
+        return;
+    }
+    state.blendSrc = srcFactor;
+    state.blendDst = dstFactor;
+    counters.issued++;
+    glBlendFunc(srcFactor, dstFactor);
+}
+
+void RenderState::setCullFace(bool enabled) {
+    setCapability(state.cullFace, GL_CULL_FACE, enabled);
+}
+
+void RenderState::setDepthTest(bool enabled) {
+    setCapability(state.depthTest, GL_DEPTH_TEST, enabled);
+}
+
+void RenderState::setDepthFunc(GLenum func) {
+    if (reversedDepth) {
+        func = reversedDepthFunc(func);
+    }
+    if (changed(state.depthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void RenderState::setDepthMask(bool enabled) {
+    if (changed(state.depthMask, enabled ? Toggle::On : Toggle::Off)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void RenderState::setPolygonMode(GLenum mode) {
+    if (changed(state.polygonMode, mode)) {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+    }
+}
+
+void RenderState::setProgramPointSize(bool enabled) {
+    setCapability(state.programPointSize, GL_PROGRAM_POINT_SIZE, enabled);
+}
+
+void RenderState::setReversedDepth(bool enabled) {
+    reversedDepth = enabled;
+    // The GL default (LESS) becomes GREATER, renderers that never set a function rely on it
+    state.depthFunc = UNKNOWN_ENUM;
+    setDepthFunc(GL_LESS);
+}
+
+void RenderState::forgetTexture(GLuint texture) {
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        if (state.textures[i] == texture) {
+            state.textures[i] = UNKNOWN_NAME;
+        }
+    }
+}
+
+void RenderState::forgetVertexArray(GLuint vao) {
+    if (state.vao == vao) {
+        state.vao = UNKNOWN_NAME;
+    }
+}
+
+void RenderState::invalidate() {
+    state = CachedState();
+}
+
+RenderState::Counters RenderState::endFrame() {
+    Counters frame = counters;
+    counters = {0, 0};
+    return frame;
+}
+
+void RenderState::installDebugCallback() {
+#ifndef NDEBUG
+    if (!GLEW_KHR_debug && !GLEW_VERSION_4_3) {
+        std::cout << "KHR_debug not available, OpenGL errors will not be reported" << std::endl;
+        return;
+    }
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(debugMessageCallback, nullptr);
+    std::cout << "OpenGL debug output enabled" << std::endl;
+#endif
+}
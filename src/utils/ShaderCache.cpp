@@ -0,0 +1,175 @@
+#include "include/utils/ShaderCache.hpp"
+#include "include/utils/AssetPack.hpp"
+#include "include/utils/EmbeddedShaders.hpp"
+#include "include/utils/ShaderUtils.hpp"
+#include "include/world/SceneBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+const char* FEATURE_NAMES[ShaderCache::FEATURE_COUNT] = {"SUN", "SHADOWS", "ATMOSPHERE"};
+
+std::string globalDefines;
+std::function<void(GLuint)> linkCallback;
+std::unordered_map<std::string, GLuint> programs; // "vertex\nfragment\nfeatures" -> program
+
+std::string normalize(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+// Text of a shader file: asset pack, then the embedded copy, then the loose file
+bool readSource(const std::string& path, std::string& text) {
+    std::string_view packed;
+    if (AssetPack::find(path, packed)) {
+        text.assign(packed.data(), packed.size());
+        return true;
+    }
+    const EmbeddedShaders::Source* end = EmbeddedShaders::SOURCES + EmbeddedShaders::SOURCE_COUNT;
+    const EmbeddedShaders::Source* found = std::lower_bound(EmbeddedShaders::SOURCES, end, path,
+        [](const EmbeddedShaders::Source& source, const std::string& wanted) {
+            return std::strcmp(source.path, wanted.c_str()) < 0;
+        });
+    if (found != end && path == found->path) {
+        text = found->text;
+        return true;
+    }
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Appends the file to output with its #includes expanded. files collects every source in order, so #line
+// directives (and with them compile errors) can name the file as "index:line".
+bool expand(const std::string& path, std::vector<std::string>& files, std::string& output) {
+    std::string text;
+    if (!readSource(path, text)) {
+        std::cerr << "Failed to open shader: " << path << std::endl;
+        return false;
+    }
+    std::string fileIndex = std::to_string(files.size());
+    files.push_back(path);
+
+    std::istringstream lines(text);
+    std::string line;
+    for (int lineNumber = 1; std::getline(lines, line); lineNumber++) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+            output += line;
+            output += '\n';
+            continue;
+        }
+
+        size_t open = line.find('"', start + 8);
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": expected #include \"file\"" << std::endl;
+            return false;
+        }
+        std::filesystem::path directory = std::filesystem::path(path).parent_path();
+        std::string included = normalize((directory / line.substr(open + 1, close - open - 1)).string());
+        // Each file once, which also stops include cycles
+        if (std::find(files.begin(), files.end(), included) == files.end()) {
+            output += "#line 1 " + std::to_string(files.size()) + "\n";
+            if (!expand(included, files, output)) {
+                return false;
+            }
+        }
+        output += "#line " + std::to_string(lineNumber + 1) + " " + fileIndex + "\n";
+    }
+    return true;
+}
+
+std::string preprocessSource(const std::string& path, uint32_t features, std::vector<std::string>& files) {
+    std::string source;
+    if (!expand(normalize(path), files, source)) {
+        return "";
+    }
+
+    // #version must stay the first line, defines go right after it
+    std::string defines = globalDefines;
+    for (int i = 0; i < ShaderCache::FEATURE_COUNT; i++) {
+        if (features & (1u << i)) {
+            defines += std::string("#define ") + FEATURE_NAMES[i] + "\n";
+        }
+    }
+    if (source.compare(0, 8, "#version") == 0) {
+        source.insert(source.find('\n') + 1, defines + "#line 2 0\n");
+    }
+    return source;
+}
+}
+
+GLuint ShaderCache::get(const std::string& vertexPath, const std::string& fragmentPath, uint32_t features) {
+    std::string key = vertexPath + '\n' + fragmentPath + '\n' + std::to_string(features);
+    auto found = programs.find(key);
+    if (found != programs.end()) {
+        return found->second;
+    }
+
+    std::vector<std::string> vertexFiles, fragmentFiles;
+    std::string vertexSource = preprocessSource(vertexPath, features, vertexFiles);
+    std::string fragmentSource = preprocessSource(fragmentPath, features, fragmentFiles);
+    GLuint program = 0;
+    if (!vertexSource.empty() && !fragmentSource.empty()) {
+        program = ShaderUtils::compileProgram(vertexSource, fragmentSource);
+
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // Errors read "file:line", with files numbered as listed here
+            std::cerr << "Shader sources for features " << features << ":";
+            for (size_t i = 0; i < vertexFiles.size(); i++) {
+                std::cerr << " vertex " << i << " = " << vertexFiles[i] << ";";
+            }
+            for (size_t i = 0; i < fragmentFiles.size(); i++) {
+                std::cerr << " fragment " << i << " = " << fragmentFiles[i] << ";";
+            }
+            std::cerr << std::endl;
+        }
+
+        if (glGetUniformBlockIndex(program, "SceneData") != GL_INVALID_INDEX) {
+            SceneBuffer::bindShader(program);
+        }
+        if (linkCallback) {
+            linkCallback(program);
+        }
+    }
+    programs[key] = program; // Failures too, so a broken shader is reported once rather than every frame
+    return program;
+}
+
+std::string ShaderCache::preprocess(const std::string& path, uint32_t features) {
+    std::vector<std::string> files;
+    return preprocessSource(path, features, files);
+}
+
+void ShaderCache::setDefines(const std::string& defines) {
+    globalDefines = defines;
+}
+
+void ShaderCache::setLinkCallback(std::function<void(GLuint)> callback) {
+    linkCallback = std::move(callback);
+}
+
+size_t ShaderCache::size() {
+    return programs.size();
+}
+
+GLuint ShaderVariants::get(uint32_t features) {
+    features &= (1u << ShaderCache::FEATURE_COUNT) - 1;
+    GLuint& program = programs[features];
+    if (program == 0) {
+        program = ShaderCache::get(vertexPath, fragmentPath, features);
+    }
+    return program;
+}
@@ -1,5 +1,19 @@
 #include "include/utils/SphereUtils.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
 #include <glm/gtc/constants.hpp>
+#include <map>
+#include <utility>
+
+namespace {
+struct SharedSphere {
+    SphereUtils::Buffers buffers;
+    unsigned int indexCount;
+};
+
+// (rings, sectors) -> sphere, every celestial body draws the same one
+std::map<std::pair<unsigned int, unsigned int>, SharedSphere> spheres;
+}
 
 void SphereUtils::generateSphereVerticesAndUVs(unsigned int rings,
                                                  unsigned int sectors,
@@ -44,43 +58,51 @@ void SphereUtils::generateSphereIndices(unsigned int rings,
     }
 }
 
-GLuint SphereUtils::setupSphereBuffers(const std::vector<glm::vec3>& vertices,
-                                        const std::vector<glm::vec2>& uvs,
-                                        const std::vector<unsigned int>& indices) {
-    GLuint vao, vbo[2], ebo;
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
+SphereUtils::Buffers SphereUtils::setupSphereBuffers(const std::vector<glm::vec3>& vertices,
+                                                     const std::vector<glm::vec2>& uvs,
+                                                     const std::vector<unsigned int>& indices) {
+    Buffers buffers;
+    buffers.vao = GlVertexArray::create();
+    RenderState::bindVertexArray(buffers.vao);
 
-    glGenBuffers(2, vbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
+    buffers.positions = GlBuffer::create();
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.positions);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, buffers.positions, MemoryBudget::Geometry, vertices.size() * sizeof(glm::vec3));
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
     glEnableVertexAttribArray(0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
+    buffers.uvs = GlBuffer::create();
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.uvs);
     glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(glm::vec2), &uvs[0], GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, buffers.uvs, MemoryBudget::Geometry, uvs.size() * sizeof(glm::vec2));
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
     glEnableVertexAttribArray(1);
 
-    glGenBuffers(1, &ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    buffers.indices = GlBuffer::create();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indices);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, buffers.indices, MemoryBudget::Geometry, indices.size() * sizeof(unsigned int));
 
-    return vao;
+    return buffers;
 }
 
-GLuint SphereUtils::createTexturedSphereVAO(unsigned int rings,
-                                              unsigned int sectors,
-                                              unsigned int& indexCount) {
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec2> uvs;
-    std::vector<unsigned int> indices;
+GLuint SphereUtils::texturedSphereVAO(unsigned int rings,
+                                      unsigned int sectors,
+                                      unsigned int& indexCount) {
+    auto found = spheres.find({rings, sectors});
+    if (found == spheres.end()) {
+        std::vector<glm::vec3> vertices;
+        std::vector<glm::vec2> uvs;
+        std::vector<unsigned int> indices;
 
-    generateSphereVerticesAndUVs(rings, sectors, vertices, uvs);
-    generateSphereIndices(rings, sectors, indices);
+        generateSphereVerticesAndUVs(rings, sectors, vertices, uvs);
+        generateSphereIndices(rings, sectors, indices);
 
-    indexCount = indices.size();
-    return setupSphereBuffers(vertices, uvs, indices);
+        SharedSphere sphere{setupSphereBuffers(vertices, uvs, indices), (unsigned int)indices.size()};
+        found = spheres.emplace(std::make_pair(rings, sectors), std::move(sphere)).first;
+    }
+    indexCount = found->second.indexCount;
+    return found->second.buffers.vao;
 }
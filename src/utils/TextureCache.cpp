@@ -0,0 +1,79 @@
+#include "include/utils/TextureCache.hpp"
+#include "include/utils/GlObject.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include "include/utils/TextureUtils.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+// Normalized path -> texture, 0 for images that failed to load
+std::unordered_map<std::string, GlTexture> textures;
+
+std::string key(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+}
+
+GLuint TextureCache::get(const std::string& path) {
+    std::string name = key(path);
+    auto found = textures.find(name);
+    if (found != textures.end()) {
+        return found->second;
+    }
+    GLuint texture = TextureUtils::loadTexture(name.c_str());
+    textures[name] = GlTexture(texture);
+    return texture;
+}
+
+void TextureCache::preload(const std::vector<std::string>& paths) {
+    // Distinct images that are not loaded yet
+    std::vector<std::string> pending;
+    for (const std::string& path : paths) {
+        if (path.empty()) {
+            continue;
+        }
+        std::string name = key(path);
+        if (textures.count(name) == 0 && std::find(pending.begin(), pending.end(), name) == pending.end()) {
+            pending.push_back(name);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    // Decoding dominates and the decoders are reentrant, so each image gets its own thread; GL stays on this one
+    struct Decoded {
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0, channels = 0;
+    };
+    std::vector<Decoded> images(pending.size());
+    parallelFor(pending.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            images[i].pixels = TextureUtils::decodeImage(pending[i].c_str(), &images[i].width, &images[i].height,
+                                                        &images[i].channels);
+        }
+    }, 1);
+
+    for (size_t i = 0; i < pending.size(); i++) {
+        GLuint texture = 0;
+        if (images[i].pixels) {
+            texture = TextureUtils::uploadTexture(images[i].pixels, images[i].width, images[i].height, images[i].channels);
+            TextureUtils::freeImage(images[i].pixels);
+            std::cout << "Texture " << pending[i] << ": " << images[i].width << "x" << images[i].height
+                      << " channels: " << images[i].channels << std::endl;
+        } else {
+            std::cerr << "Failed to load texture: " << pending[i] << std::endl;
+        }
+        textures[pending[i]] = GlTexture(texture);
+    }
+}
+
+size_t TextureCache::size() {
+    return textures.size();
+}
+
+void TextureCache::clear() {
+    textures.clear();
+}
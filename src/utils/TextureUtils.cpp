@@ -1,39 +1,85 @@
 #include "include/utils/TextureUtils.hpp"
-#include "stb_image.h"
+#include "include/utils/AssetPack.hpp"
+#include "include/utils/ImageDecoder.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
 
 GLuint TextureUtils::loadTexture(const char* path) {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-
     std::cout << "Loading texture from path: " << path << std::endl;
 
     int width, height, nrChannels;
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-    if (data) {
-        std::cout << "Texture loaded successfully: " << width << "x" << height 
-                  << " channels: " << nrChannels << std::endl;
-
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // Check for OpenGL errors
-        GLenum err;
-        while ((err = glGetError()) != GL_NO_ERROR) {
-            std::cerr << "OpenGL error in loadTexture: " << err << std::endl;
-        }
-
-        stbi_image_free(data);
-    } else {
+    unsigned char* data = decodeImage(path, &width, &height, &nrChannels);
+    if (!data) {
         std::cerr << "Failed to load texture: " << path << std::endl;
-        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
-        stbi_image_free(data);
+        std::cerr << "Decoder error: " << ImageDecoder::failureReason() << std::endl;
         return 0; // Return 0 to indicate failure
     }
+    std::cout << "Texture loaded successfully: " << width << "x" << height
+              << " channels: " << nrChannels << std::endl;
+
+    GLuint textureID = uploadTexture(data, width, height, nrChannels);
+    freeImage(data);
     return textureID;
 }
+
+unsigned char* TextureUtils::decodeImage(const char* path, int* width, int* height, int* channels) {
+    // The whole file goes to the decoder at once: in place from the pack, else with a single read
+    std::string_view packed;
+    std::string bytes;
+    if (!AssetPack::find(path, packed)) {
+        std::ifstream file(path, std::ios::binary);
+        if (file) {
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            packed = bytes;
+        }
+    }
+    const unsigned char* data = packed.empty() ? nullptr : reinterpret_cast<const unsigned char*>(packed.data());
+    return ImageDecoder::decodeAny(data, packed.size(), width, height, channels);
+}
+
+void TextureUtils::freeImage(unsigned char* pixels) {
+    std::free(pixels);
+}
+
+GLuint TextureUtils::uploadTexture(const unsigned char* pixels, int width, int height, int channels) {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+
+    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+    RenderState::bindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Drivers pad RGB to four bytes per texel, and the mip chain adds a third
+    MemoryBudget::trackGpu(GlKind::Texture, textureID, MemoryBudget::Textures, size_t(width) * height * 4 * 4 / 3);
+    return textureID;
+}
+
+glm::vec3 TextureUtils::averageColor(GLuint texture) {
+    if (texture == 0) {
+        return glm::vec3(0.5f);
+    }
+
+    RenderState::bindTexture(GL_TEXTURE_2D, texture);
+    GLint width = 0, height = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    if (width <= 0 || height <= 0) {
+        return glm::vec3(0.5f);
+    }
+
+    // glGenerateMipmap already box-filtered the whole image down to one texel
+    GLint topLevel = static_cast<GLint>(std::floor(std::log2(static_cast<float>(std::max(width, height)))));
+    GLfloat texel[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+    glGetTexImage(GL_TEXTURE_2D, topLevel, GL_RGBA, GL_FLOAT, texel);
+    return glm::vec3(texel[0], texel[1], texel[2]);
+}
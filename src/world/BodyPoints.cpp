@@ -0,0 +1,105 @@
+#include "include/world/BodyPoints.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+BodyPoints BodyPoints::create(float referenceSunDistance, float viewportHeight) {
+    BodyPoints bodyPoints;
+    bodyPoints.referenceSunDistance = referenceSunDistance;
+    bodyPoints.viewportHeight = viewportHeight;
+    bodyPoints.capacity = 0;
+
+    bodyPoints.vao = GlVertexArray::create();
+    bodyPoints.vbo = GlBuffer::create();
+
+    RenderState::bindVertexArray(bodyPoints.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, bodyPoints.vbo);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)offsetof(Point, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)offsetof(Point, color));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)offsetof(Point, logFlux));
+    glEnableVertexAttribArray(2);
+
+    return bodyPoints;
+}
+
+float BodyPoints::projectedPixelRadius(const glm::dvec3& position,
+                                       float radius,
+                                       const glm::dvec3& eyePosition,
+                                       const glm::mat4& projectionMatrix) const {
+    float distance = float(glm::length(position - eyePosition));
+    if (distance <= radius) {
+        return viewportHeight; // Camera inside the body
+    }
+    // projection[1][1] = 1 / tan(fov / 2) maps view-space size to half the viewport height
+    return radius / distance * projectionMatrix[1][1] * viewportHeight * 0.5f;
+}
+
+bool BodyPoints::add(const CelestialBody& body,
+                     const glm::dvec3& sunPosition,
+                     const glm::dvec3& eyePosition,
+                     const FloatingOrigin& origin,
+                     const glm::mat4& projectionMatrix) {
+    float pixelRadius = projectedPixelRadius(body.position, body.scale.x, eyePosition, projectionMatrix);
+    if (pixelRadius >= MIN_PIXEL_RADIUS) {
+        return false;
+    }
+
+    // Albedo from the texture's average color, hue kept separately so dark bodies stay tinted
+    glm::vec3 averageColor = body.averageColor;
+    float albedo = glm::dot(averageColor, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+    float maxChannel = std::max(averageColor.x, std::max(averageColor.y, averageColor.z));
+
+    // Reflected flux ~ albedo * disk area * sunlight, disk area already carries the distance to the camera
+    float sunDistance = std::max(float(glm::length(body.position - sunPosition)), 0.001f);
+    float sunlight = (referenceSunDistance * referenceSunDistance) / (sunDistance * sunDistance);
+    float relativeArea = (pixelRadius * pixelRadius) / (MIN_PIXEL_RADIUS * MIN_PIXEL_RADIUS);
+    float flux = std::max(albedo * relativeArea * sunlight, 1e-6f);
+
+    Point point;
+    point.position = origin.toRender(body.position);
+    point.color = maxChannel > 0.0f ? averageColor / maxChannel : glm::vec3(1.0f);
+    point.logFlux = std::log(flux);
+    points.push_back(point);
+    return true;
+}
+
+void BodyPoints::clear() {
+    points.clear();
+}
+
+void BodyPoints::render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (points.empty()) {
+        return;
+    }
+
+    // Orphan and refill each frame, growing only when more bodies fall below the threshold
+    GLsizeiptr size = points.size() * sizeof(Point);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (size > capacity) {
+        capacity = size * 2;
+        MemoryBudget::trackGpu(GlKind::Buffer, vbo, MemoryBudget::Geometry, capacity);
+    }
+    glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, points.data());
+
+    RenderState::setDepthTest(true);
+    RenderState::setDepthMask(false);
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_ONE, GL_ONE); // Overlapping points add up
+    RenderState::setProgramPointSize(true);    // The vertex shader sizes each sprite
+    RenderState::useProgram(shader);
+
+    glUniformMatrix4fv(glGetUniformLocation(shader, "view"), 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+
+    RenderState::bindVertexArray(vao);
+    glDrawArrays(GL_POINTS, 0, points.size());
+
+    RenderState::setDepthMask(true);
+}
@@ -15,14 +15,14 @@ void Camera::updateForSelectedPlanet(CelestialBody* selectedBody, float dt) {
     viewingDistance = std::max(3.0f, viewingDistance);    // Minimum distance
 
     // Calculate desired camera position (slightly above and behind the planet)
-    vec3 targetPosition = selectedBody->position + vec3(0.0f, viewingDistance * 0.3f, viewingDistance);
+    dvec3 targetPosition = selectedBody->position + dvec3(0.0, viewingDistance * 0.3, viewingDistance);
 
     // Smooth camera movement (lerp towards target)
-    float lerpSpeed = 2.0f * dt; // Adjust speed as needed
+    double lerpSpeed = 2.0 * dt; // Adjust speed as needed
     position = mix(position, targetPosition, lerpSpeed);
 
     // Make camera look at the selected planet
-    vec3 directionToPlanet = normalize(selectedBody->position - position);
+    vec3 directionToPlanet = vec3(normalize(selectedBody->position - position));
     lookAt = directionToPlanet;
 }
 
@@ -45,37 +45,40 @@ void Camera::updatePosition(GLFWwindow* window, float dt) {
     float currentCameraSpeed = fastCam ? fastSpeed : speed;
     vec3 cameraSideVector = cross(lookAt, up);
 
+    // Movement is summed in float, the step is small; accumulating into the double position keeps it exact far out
+    vec3 movement(0.0f);
     if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-        position += lookAt * dt * currentCameraSpeed;
+        movement += lookAt;
     }
     if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-        position -= lookAt * dt * currentCameraSpeed;
+        movement -= lookAt;
     }
     if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-        position -= cameraSideVector * dt * currentCameraSpeed;
+        movement -= cameraSideVector;
     }
     if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-        position += cameraSideVector * dt * currentCameraSpeed;
+        movement += cameraSideVector;
     }
     if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
-        position += up * dt * currentCameraSpeed;
+        movement += up;
     }
     if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
-        position -= up * dt * currentCameraSpeed;
+        movement -= up;
     }
+    position += dvec3(movement * dt * currentCameraSpeed);
+}
+
+glm::dvec3 Camera::eyePosition() const
+{
+    // Distance from target in third-person
+    const float radius = 1.5f;
+    return firstPerson ? position : position - glm::dvec3(radius * lookAt);
 }
 
 glm::mat4 Camera::updateViewMatrix() const
 {
-    if (firstPerson)
-    {
-        return glm::lookAt(position, position + lookAt, up);
-    }
-    else
-    {
-        // Distance from target in third-person
-        float radius = 1.5f;
-        glm::vec3 position = this->position - radius * lookAt;
-        return glm::lookAt(position, position + lookAt, up);
-    }
+    // The eye relative to the origin is zero in first-person and a short offset in third-person,
+    // so the matrix never carries large translations
+    glm::vec3 eye = glm::vec3(eyePosition() - position);
+    return glm::lookAt(eye, eye + lookAt, up);
 }
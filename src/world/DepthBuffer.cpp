@@ -0,0 +1,116 @@
+#include "include/world/DepthBuffer.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <iostream>
+
+DepthBuffer DepthBuffer::create(LaunchOptions::DepthMode requested, int width, int height) {
+    DepthBuffer depth;
+    depth.mode = requested;
+    depth.width = width;
+    depth.height = height;
+
+    if (depth.mode == LaunchOptions::DepthMode::Reversed && !GLEW_VERSION_4_5 && !GLEW_ARB_clip_control) {
+        std::cout << "glClipControl not available, using logarithmic depth instead of reversed-Z" << std::endl;
+        depth.mode = LaunchOptions::DepthMode::Logarithmic;
+    }
+
+    if (depth.mode == LaunchOptions::DepthMode::Standard) {
+        depth.nearPlane = 0.01f;
+        depth.farPlane = 100.0f;
+        return depth;
+    }
+
+    // Both extended modes keep precision over a 10^12 range in one pass
+    depth.nearPlane = 1e-5f;
+    depth.farPlane = 1e7f;
+
+    if (depth.mode == LaunchOptions::DepthMode::Reversed) {
+        // The window's depth buffer is fixed point, so reversed-Z renders into a float depth attachment
+        depth.framebuffer = GlFramebuffer::create();
+        glBindFramebuffer(GL_FRAMEBUFFER, depth.framebuffer);
+
+        depth.colorBuffer = GlRenderbuffer::create();
+        glBindRenderbuffer(GL_RENDERBUFFER, depth.colorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, depth.colorBuffer);
+
+        depth.depthBuffer = GlRenderbuffer::create();
+        glBindRenderbuffer(GL_RENDERBUFFER, depth.depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth.depthBuffer);
+        MemoryBudget::trackGpu(GlKind::Renderbuffer, depth.colorBuffer, MemoryBudget::Framebuffers, size_t(width) * height * 4);
+        MemoryBudget::trackGpu(GlKind::Renderbuffer, depth.depthBuffer, MemoryBudget::Framebuffers, size_t(width) * height * 4);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Reversed-Z framebuffer incomplete, using logarithmic depth instead" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            depth.framebuffer.reset();
+            depth.colorBuffer.reset();
+            depth.depthBuffer.reset();
+            depth.mode = LaunchOptions::DepthMode::Logarithmic;
+            return depth;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+        glClearDepth(0.0);
+        RenderState::setReversedDepth(true);
+    }
+
+    return depth;
+}
+
+glm::mat4 DepthBuffer::projection(float fovy, float aspect) const {
+    glm::mat4 projection = glm::perspective(fovy, aspect, nearPlane, farPlane);
+    if (mode == LaunchOptions::DepthMode::Reversed) {
+        // Same x/y as glm, but z/w = near -> 1 and far -> 0 for the [0, 1] clip range
+        projection[2][2] = nearPlane / (farPlane - nearPlane);
+        projection[3][2] = nearPlane * farPlane / (farPlane - nearPlane);
+    }
+    return projection;
+}
+
+std::string DepthBuffer::shaderDefines() const {
+    switch (mode) {
+    case LaunchOptions::DepthMode::Reversed: return "#define REVERSED_Z\n";
+    case LaunchOptions::DepthMode::Logarithmic: return "#define LOG_DEPTH\n";
+    default: return "";
+    }
+}
+
+void DepthBuffer::bindShader(GLuint shader) const {
+    if (mode != LaunchOptions::DepthMode::Logarithmic) {
+        return;
+    }
+    RenderState::useProgram(shader);
+    glUniform1f(glGetUniformLocation(shader, "logDepthCoefficient"), 1.0f / std::log2(farPlane + 1.0f));
+}
+
+void DepthBuffer::beginFrame() const {
+    if (framebuffer != 0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+    // Depth writes must be on for the clear to reach the depth buffer
+    RenderState::setDepthMask(true);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void DepthBuffer::endFrame() const {
+    if (framebuffer == 0) {
+        return;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+const char* DepthBuffer::name() const {
+    switch (mode) {
+    case LaunchOptions::DepthMode::Reversed: return "reversed-Z";
+    case LaunchOptions::DepthMode::Logarithmic: return "logarithmic";
+    default: return "standard";
+    }
+}
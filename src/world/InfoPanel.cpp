@@ -1,219 +1,62 @@
 #include "include/world/InfoPanel.hpp"
-#include "include/utils/TextureUtils.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-InfoPanel::InfoPanel() : visible(false), wasIPressed(false), fadeAlpha(0.0f), currentTexture(0) {}
-
-void InfoPanel::loadPlanetTextures() {
-    planetNames = {
-        "sun",
-        "mercury",
-        "mars",
-        "venus",
-        "earth",
-        "moon",
-        "neptune",
-        "uranus",
-        "saturn",
-        "jupiter",
-    };
-
-    for (const std::string& planetName : planetNames) {
-        std::string texturePath = "textures/planet_info/" + planetName + "_info.png";
-        std::cout << "Attempting to load: " << texturePath << std::endl;
-
-        GLuint texture = TextureUtils::loadTexture(texturePath.c_str());
-        if (texture == 0) {
-            std::cout << "Warning: Failed to load planet info texture for " << planetName << std::endl;
-            if (texture == 0) {
-                texture = TextureUtils::loadTexture("textures/planet/sun.jpg");
-            }
-        } else {
-            std::cout << "Successfully loaded texture for " << planetName << " with ID: " << texture << std::endl;
-        }
-        planetTextures.push_back(texture);
-    }
+InfoPanel InfoPanel::create() {
+    InfoPanel panel;
+    panel.visible = false;
+    panel.wasIPressed = false;
+    panel.fadeAlpha = 0.0f;
+    panel.text = TextRenderer::create();
+    panel.layoutPending = false;
+    return panel;
 }
 
 void InfoPanel::show(const PlanetInfo& info) {
-    currentInfo = info;
+    if (info != currentInfo || text.vertexCount == 0) {
+        currentInfo = info;
+        layoutPending = true;
+    }
     visible = true;
     fadeAlpha = 1.0f;
-
-    for (size_t i = 0; i < planetNames.size(); i++) {
-        std::string infoNameLower = info.name;
-        std::transform(infoNameLower.begin(), infoNameLower.end(), infoNameLower.begin(), ::tolower);
-
-        if (infoNameLower == planetNames[i]) {
-            currentTexture = planetTextures[i];
-            std::cout << "Displaying " << info.name << " information on screen" << std::endl;
-            return;
-        }
-    }
-
-    if (!planetTextures.empty()) {
-        currentTexture = planetTextures[0];
-    }
+    std::cout << "Displaying " << info.name << " information on screen" << std::endl;
 }
 
 void InfoPanel::hide() {
     visible = false;
 }
 
-void InfoPanel::renderBackground(GLuint shader, int windowWidth, int windowHeight) const {
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST); // Render on top of everything
-
-    glUseProgram(shader);
+void InfoPanel::layout() {
+    const float padding = 16.0f;
+    const float textWidth = WIDTH - 2.0f * padding;
 
-    // Set up orthographic projection for 2D overlay
-    glm::mat4 orthoProjection = glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight, -1.0f, 1.0f);
-    glm::mat4 viewMatrix = glm::mat4(1.0f); // Identity
+    text.clear();
+    // Sized once the text height is known, drawn first so the text blends over it
+    size_t background = text.addRect(0.0f, 0.0f, WIDTH, 0.0f, glm::vec4(0.1f, 0.1f, 0.3f, 0.8f));
 
-    // Panel dimensions and position (top-right corner)
-    float panelWidth = 300.0f;
-    float panelHeight = 180.0f;
-    float margin = 20.0f;
-    float panelX = windowWidth - panelWidth - margin;
-    float panelY = windowHeight - panelHeight - margin;
-
-    // Create a simple quad for the background
-    float vertices[] = {
-        // Positions        // Colors (dark blue with transparency)
-        panelX, panelY, 0.1f, 0.1f, 0.3f,             // Bottom-left
-        panelX + panelWidth, panelY, 0.1f, 0.1f, 0.3f,         // Bottom-right
-        panelX + panelWidth, panelY + panelHeight, 0.1f, 0.1f, 0.3f,  // Top-right
-        panelX, panelY + panelHeight, 0.1f, 0.1f, 0.3f         // Top-left
-    };
-
-    unsigned int indices[] = {
-        0, 1, 2,  // First triangle
-        2, 3, 0   // Second triangle
-    };
-
-    static GLuint VAO = 0, VBO = 0, EBO = 0;
-
-    // Create buffers if not already created
-    if (VAO == 0) {
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
+    float y = text.addText(currentInfo.name, padding, padding, 3.0f, textWidth, glm::vec4(1.0f, 0.85f, 0.45f, 1.0f));
+    y += 6.0f;
+    if (!currentInfo.description.empty()) {
+        y = text.addText(currentInfo.description, padding, y, 2.0f, textWidth, glm::vec4(0.9f, 0.9f, 0.95f, 1.0f));
+        y += 8.0f;
+    }
+    for (const std::string& fact : currentInfo.facts) {
+        if (!fact.empty()) {
+            y = text.addText("- " + fact, padding, y, 2.0f, textWidth, glm::vec4(0.7f, 0.85f, 1.0f, 1.0f));
+        }
     }
 
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Color attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Set matrices
-    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &orthoProjection[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "worldMatrix"), 1, GL_FALSE, &glm::mat4(1.0f)[0][0]);
-
-    // Set alpha for fading
-    glUniform1f(glGetUniformLocation(shader, "alpha"), fadeAlpha * 0.8f); // Semi-transparent
-
-    // Draw the quad
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    text.resizeRect(background, WIDTH, y + padding);
+    text.upload();
 }
 
 void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeight) const {
     if (fadeAlpha <= 0.0f)
         return;
 
-    // Show default message if no planet is selected or no texture
-    if (currentTexture == 0) {
-        std::cout << "Info Panel: No planet selected. Press '3' to enter planet selection mode." << std::endl;
-        return;
-    }
-
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
-
-    glUseProgram(uiShader);
-
-    // Set up orthographic projection for 2D overlay
     glm::mat4 orthoProjection = glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight);
-
-    // Panel dimensions and position (top-right corner)
-    float panelWidth = 400.0f;
-    float panelHeight = 250.0f;
-    float margin = 20.0f;
-    float panelX = windowWidth - panelWidth - margin;
-    float panelY = windowHeight - panelHeight - margin;
-
-    // Create textured quad vertices
-    float vertices[] = {
-        // Positions        // Texture Coords
-        panelX, panelY, 0.0f, 1.0f,                        // Bottom-left
-        panelX + panelWidth, panelY, 1.0f, 1.0f,          // Bottom-right
-        panelX + panelWidth, panelY + panelHeight, 1.0f, 0.0f,  // Top-right
-        panelX, panelY + panelHeight, 0.0f, 0.0f          // Top-left
-    };
-
-    unsigned int indices[] = {
-        0, 1, 2,  // First triangle
-        2, 3, 0   // Second triangle
-    };
-
-    static GLuint VAO = 0, VBO = 0, EBO = 0;
-
-    // Create buffers if not already created
-    if (VAO == 0) {
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-    }
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Texture coordinate attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Bind the planet info texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, currentTexture);
-    glUniform1i(glGetUniformLocation(uiShader, "ourTexture"), 0);
-
-    // Set projection matrix and alpha
-    glUniformMatrix4fv(glGetUniformLocation(uiShader, "projection"), 1, GL_FALSE, &orthoProjection[0][0]);
-    glUniform1f(glGetUniformLocation(uiShader, "alpha"), fadeAlpha);
-
-    // Draw the textured quad
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    glm::vec2 topLeft(windowWidth - WIDTH - MARGIN, windowHeight - MARGIN);
+    text.render(uiShader, orthoProjection, topLeft, fadeAlpha);
 }
 
 void InfoPanel::toggle(const PlanetInfo& info) {
@@ -230,6 +73,11 @@ void InfoPanel::update(float dt) {
     } else if (!visible && fadeAlpha > 0.0f) {
         fadeAlpha = std::max(0.0f, fadeAlpha - dt * 3.0f);
     }
+
+    if (layoutPending) {
+        layout();
+        layoutPending = false;
+    }
 }
 
 void InfoPanel::handleInput(GLFWwindow* window, const PlanetInfo& currentPlanetInfo) {
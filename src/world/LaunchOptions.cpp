@@ -0,0 +1,110 @@
+#include "include/world/LaunchOptions.hpp"
+#include "include/physics/Ephemeris.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+// Whole number in [0, max]; strtoul alone accepts "-5" and wraps it to a huge count
+bool parseCount(const std::string& value, unsigned long max, unsigned int& count) {
+    if (value.empty() || value[0] < '0' || value[0] > '9') {
+        return false;
+    }
+    char* end = nullptr;
+    unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+    if (*end != '\0' || parsed > max) {
+        return false;
+    }
+    count = static_cast<unsigned int>(parsed);
+    return true;
+}
+}
+
+LaunchOptions LaunchOptions::parse(int argc, char* argv[]) {
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        std::string name = arg.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+
+        if (name == "--scene") {
+            options.scenePath = value;
+        } else if (name == "--sky") {
+            if (value == "stars") {
+                options.skyMode = SkyMode::Starfield;
+            } else if (value == "cubemap") {
+                options.skyMode = SkyMode::Cubemap;
+            } else {
+                std::cerr << "Unknown sky mode '" << value << "', expected cubemap or stars" << std::endl;
+            }
+        } else if (name == "--star-catalog") {
+            options.starCatalogPath = value;
+        } else if (name == "--bodies") {
+            if (value == "impostor") {
+                options.bodyMode = BodyMode::Impostor;
+            } else if (value == "mesh") {
+                options.bodyMode = BodyMode::Mesh;
+            } else {
+                std::cerr << "Unknown body mode '" << value << "', expected mesh or impostor" << std::endl;
+            }
+        } else if (name == "--asteroids") {
+            if (!parseCount(value, MAX_ASTEROIDS, options.asteroidCount)) {
+                std::cerr << "Invalid asteroid count '" << value << "', expected a whole number up to "
+                          << MAX_ASTEROIDS << std::endl;
+            }
+        } else if (name == "--small-bodies") {
+            options.smallBodyCatalogPath = value;
+        } else if (name == "--assets") {
+            options.assetPackPath = value;
+        } else if (name == "--gpu-budget" || name == "--cpu-budget") {
+            unsigned int& budget = name == "--gpu-budget" ? options.gpuBudgetMB : options.cpuBudgetMB;
+            if (!parseCount(value, MAX_BUDGET_MB, budget)) {
+                std::cerr << "Invalid memory budget '" << value << "', expected megabytes up to " << MAX_BUDGET_MB
+                          << std::endl;
+            }
+        } else if (name == "--physics") {
+            if (value == "barnes-hut") {
+                options.physicsMode = PhysicsMode::BarnesHut;
+            } else if (value == "direct") {
+                options.physicsMode = PhysicsMode::Direct;
+            } else if (value == "ephemeris") {
+                options.physicsMode = PhysicsMode::Ephemeris;
+            } else if (value == "scripted") {
+                options.physicsMode = PhysicsMode::Scripted;
+            } else {
+                std::cerr << "Unknown physics mode '" << value << "', expected scripted, barnes-hut, direct or ephemeris"
+                          << std::endl;
+            }
+        } else if (name == "--theta") {
+            char* end = nullptr;
+            double theta = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || theta < 0.0) {
+                std::cerr << "Invalid opening angle '" << value << "', expected a number >= 0" << std::endl;
+            } else {
+                options.theta = theta;
+            }
+        } else if (name == "--depth") {
+            if (value == "reversed") {
+                options.depthMode = DepthMode::Reversed;
+            } else if (value == "log") {
+                options.depthMode = DepthMode::Logarithmic;
+            } else if (value == "standard") {
+                options.depthMode = DepthMode::Standard;
+            } else {
+                std::cerr << "Unknown depth mode '" << value << "', expected standard, reversed or log" << std::endl;
+            }
+        } else if (name == "--date") {
+            double julianDate;
+            if (!Ephemeris::parseDate(value, julianDate)) {
+                std::cerr << "Invalid date '" << value << "', expected YYYY-MM-DD" << std::endl;
+            } else {
+                options.startDate = value;
+            }
+        } else {
+            std::cerr << "Ignoring unknown option: " << arg << std::endl;
+        }
+    }
+
+    return options;
+}
@@ -0,0 +1,56 @@
+#include "include/world/RenderQueue.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int PASS_SHIFT = 61;
+const uint64_t SHADER_MASK = (1ull << 10) - 1;
+const uint64_t TEXTURE_MASK = (1ull << 16) - 1;
+const uint64_t DEPTH_MASK = (1ull << 24) - 1;
+const int BUCKET_SHIFT = 20; // Opaque buckets are the top 4 depth bits
+}
+
+RenderQueue::RenderQueue(float nearDistance, float farDistance) : nearDistance(nearDistance), farDistance(farDistance) {}
+
+uint64_t RenderQueue::makeKey(Pass pass, GLuint shader, GLuint texture, float viewDistance) const {
+    uint64_t key = static_cast<uint64_t>(pass) << PASS_SHIFT;
+    if (pass == Sky || pass == Overlay) {
+        return key;
+    }
+
+    // Quantize log distance to 24 bits over [nearDistance, farDistance]
+    float normalized = std::log(std::max(viewDistance, nearDistance) / nearDistance) / std::log(farDistance / nearDistance);
+    normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+    uint64_t depth = static_cast<uint64_t>(normalized * DEPTH_MASK);
+    uint64_t shaderBits = shader & SHADER_MASK;
+    uint64_t textureBits = texture & TEXTURE_MASK;
+
+    if (pass == Opaque) {
+        // Group by shader, then front-to-back by bucket, texture and exact depth
+        key |= shaderBits << 51;
+        key |= (depth >> BUCKET_SHIFT) << 47;
+        key |= textureBits << 31;
+        key |= depth << 7;
+    } else {
+        // Farthest first, state only breaks ties
+        key |= (DEPTH_MASK - depth) << 37;
+        key |= shaderBits << 27;
+        key |= textureBits << 11;
+    }
+    return key;
+}
+
+void RenderQueue::submit(uint64_t sortKey, std::function<void()> draw) {
+    packets.push_back({sortKey, std::move(draw)});
+}
+
+void RenderQueue::flush() {
+    std::stable_sort(packets.begin(), packets.end(), [](const DrawPacket& a, const DrawPacket& b) {
+        return a.sortKey < b.sortKey;
+    });
+
+    for (const DrawPacket& packet : packets) {
+        packet.draw();
+    }
+    packets.clear();
+}
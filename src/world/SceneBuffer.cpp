@@ -0,0 +1,86 @@
+#include "include/world/SceneBuffer.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// std140 header in front of the body array: ivec4(bodyCount, 0, 0, 0)
+const GLsizeiptr HEADER_SIZE = 4 * sizeof(GLint);
+}
+
+SceneBuffer SceneBuffer::create() {
+    SceneBuffer scene;
+
+    // Every slice must start on a legal glBindBufferRange offset
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    GLsizeiptr dataSize = HEADER_SIZE + MAX_BODIES * sizeof(glm::vec4);
+    scene.sliceSize = (dataSize + alignment - 1) / alignment * alignment;
+    scene.currentSlice = 0;
+
+    for (int i = 0; i < FRAMES_IN_FLIGHT; i++) {
+        scene.fences[i] = 0;
+    }
+
+    scene.ubo = GlBuffer::create();
+    glBindBuffer(GL_UNIFORM_BUFFER, scene.ubo);
+    glBufferData(GL_UNIFORM_BUFFER, scene.sliceSize * FRAMES_IN_FLIGHT, nullptr, GL_DYNAMIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, scene.ubo, MemoryBudget::Uniforms, scene.sliceSize * FRAMES_IN_FLIGHT);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    return scene;
+}
+
+void SceneBuffer::bindShader(GLuint shader) {
+    GLuint blockIndex = glGetUniformBlockIndex(shader, "SceneData");
+    if (blockIndex == GL_INVALID_INDEX) {
+        std::cerr << "Warning: Uniform block 'SceneData' not found in shader" << std::endl;
+        return;
+    }
+    glUniformBlockBinding(shader, blockIndex, BINDING_POINT);
+}
+
+void SceneBuffer::update(const std::vector<glm::vec4>& bodies) {
+    GLint count = static_cast<GLint>(std::min<size_t>(bodies.size(), MAX_BODIES));
+    if (bodies.size() > static_cast<size_t>(MAX_BODIES)) {
+        static bool warned = false;
+        if (!warned) {
+            std::cerr << "Warning: " << bodies.size() << " shadow casters exceeds limit of " << MAX_BODIES
+                      << ", extra bodies are ignored" << std::endl;
+            warned = true;
+        }
+    }
+
+    // Wait until the GPU has finished the frame that last used this slice (normally already signalled)
+    if (fences[currentSlice]) {
+        glClientWaitSync(fences[currentSlice], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        glDeleteSync(fences[currentSlice]);
+        fences[currentSlice] = 0;
+    }
+
+    GLintptr offset = currentSlice * sliceSize;
+    GLsizeiptr writeSize = HEADER_SIZE + count * sizeof(glm::vec4);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    void* ptr = glMapBufferRange(GL_UNIFORM_BUFFER,
+                                 offset,
+                                 writeSize,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (ptr) {
+        GLint header[4] = {count, 0, 0, 0};
+        memcpy(ptr, header, HEADER_SIZE);
+        if (count > 0) {
+            memcpy(static_cast<char*>(ptr) + HEADER_SIZE, &bodies[0], count * sizeof(glm::vec4));
+        }
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, BINDING_POINT, ubo, offset, sliceSize);
+}
+
+void SceneBuffer::endFrame() {
+    fences[currentSlice] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    currentSlice = (currentSlice + 1) % FRAMES_IN_FLIGHT;
+}
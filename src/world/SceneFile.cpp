@@ -0,0 +1,450 @@
+#include "include/world/SceneFile.hpp"
+#include "include/physics/KeplerianElements.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+const char MAGIC[4] = {'S', 'S', 'C', 'N'};
+
+// Names accepted by the ephemeris key, in KeplerianElements::Body order
+const char* EPHEMERIS_BODIES[KeplerianElements::BODY_COUNT] = {
+    "Mercury", "Venus", "Earth", "Mars", "Jupiter", "Saturn", "Uranus", "Neptune", "Moon",
+};
+
+// Deduplicated string table, offset 0 holds the empty string
+struct StringTable {
+    std::string bytes = std::string(1, '\0');
+    std::unordered_map<std::string, uint32_t> offsets;
+
+    uint32_t add(const std::string& text) {
+        if (text.empty()) {
+            return 0;
+        }
+        auto found = offsets.find(text);
+        if (found != offsets.end()) {
+            return found->second;
+        }
+        uint32_t offset = uint32_t(bytes.size());
+        bytes += text;
+        bytes += '\0';
+        offsets[text] = offset;
+        return offset;
+    }
+};
+
+// Reads exactly count numbers from text
+bool readFloats(const std::string& text, float* values, int count) {
+    std::istringstream stream(text);
+    for (int i = 0; i < count; i++) {
+        if (!(stream >> values[i])) {
+            return false;
+        }
+    }
+    std::string trailing;
+    return !(stream >> trailing);
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool sourceInfo(const std::string& path, int64_t& time, uint64_t& size) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    time = int64_t(info.st_mtime);
+    size = uint64_t(info.st_size);
+    return true;
+}
+
+// Structural checks so a damaged or hand-made binary cannot send reads outside the mapping
+bool validate(const unsigned char* data, size_t size) {
+    if (size < sizeof(SceneFile::FileHeader)) {
+        return false;
+    }
+    const SceneFile::FileHeader* header = reinterpret_cast<const SceneFile::FileHeader*>(data);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != SceneFile::VERSION) {
+        return false;
+    }
+    uint64_t expected = sizeof(SceneFile::FileHeader) + uint64_t(header->bodyCount) * sizeof(SceneFile::BodyRecord) +
+                        uint64_t(header->selectionCount) * sizeof(uint32_t) + header->stringBytes;
+    if (expected != size || header->stringBytes == 0 || data[size - 1] != '\0' ||
+        header->referenceBody >= int32_t(header->bodyCount)) {
+        return false;
+    }
+
+    const SceneFile::BodyRecord* bodies = reinterpret_cast<const SceneFile::BodyRecord*>(header + 1);
+    for (uint32_t i = 0; i < header->bodyCount; i++) {
+        const SceneFile::BodyRecord& body = bodies[i];
+        uint32_t strings[] = {body.name, body.texture, body.description, body.facts[0], body.facts[1],
+                              body.facts[2], body.ringTexture};
+        for (uint32_t offset : strings) {
+            if (offset >= header->stringBytes) {
+                return false;
+            }
+        }
+        if (body.kind > SceneFile::Comet || body.parent >= int32_t(i) ||
+            body.ephemeris >= KeplerianElements::BODY_COUNT) {
+            return false;
+        }
+    }
+
+    const uint32_t* selection = reinterpret_cast<const uint32_t*>(bodies + header->bodyCount);
+    for (uint32_t i = 0; i < header->selectionCount; i++) {
+        if (selection[i] >= header->bodyCount) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+SceneFile SceneFile::load(const std::string& scenePath, const std::string& binaryPath) {
+    SceneFile scene;
+    int64_t sourceTime = 0;
+    uint64_t sourceSize = 0;
+    bool haveSource = sourceInfo(scenePath, sourceTime, sourceSize);
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int fd = open(binaryPath.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            void* mapped = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd); // The mapping stays valid after the descriptor is closed
+
+            if (mapped != MAP_FAILED) {
+                const unsigned char* data = static_cast<const unsigned char*>(mapped);
+                const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+                bool matches = validate(data, info.st_size) &&
+                               (!haveSource || (header->sourceTime == sourceTime && header->sourceSize == sourceSize));
+                if (matches) {
+                    scene.data = data;
+                    scene.size = info.st_size;
+                    MemoryBudget::trackCpu(MemoryBudget::Caches, int64_t(scene.size));
+                    return scene;
+                }
+                munmap(mapped, info.st_size);
+            }
+        }
+
+        if (attempt == 0 && haveSource) {
+            std::cout << "Compiling scene " << scenePath << " into " << binaryPath << std::endl;
+            if (!compile(scenePath, binaryPath)) {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    std::cerr << "Failed to load scene: " << scenePath << std::endl;
+    return scene;
+}
+
+bool SceneFile::compile(const std::string& scenePath, const std::string& binaryPath) {
+    std::ifstream input(scenePath);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open scene: " << scenePath << std::endl;
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.referenceBody = -1;
+    sourceInfo(scenePath, header.sourceTime, header.sourceSize);
+
+    std::vector<BodyRecord> bodies;
+    std::vector<std::string> names;
+    std::vector<int> factCounts;
+    StringTable strings;
+    std::string referenceName;
+    std::vector<std::string> selectionNames;
+    int selectionLine = 0, referenceLine = 0;
+
+    auto findName = [&names](const std::string& name) -> int {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == name) {
+                return int(i);
+            }
+        }
+        return -1;
+    };
+
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && std::getline(input, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t space = line.find_first_of(" \t");
+        std::string key = line.substr(0, space);
+        std::string value = space == std::string::npos ? "" : trim(line.substr(space));
+        auto fail = [&](const std::string& message) {
+            std::cerr << scenePath << ":" << lineNumber << ": " << message << std::endl;
+            ok = false;
+        };
+
+        // Top-level settings
+        if (key == "reference") {
+            referenceName = value;
+            referenceLine = lineNumber;
+            continue;
+        }
+        if (key == "belt") {
+            float radii[2];
+            if (!readFloats(value, radii, 2) || radii[0] < 0.0f || radii[1] < radii[0]) {
+                fail("expected 'belt <inner radius> <outer radius>'");
+            }
+            header.beltInner = radii[0];
+            header.beltOuter = radii[1];
+            continue;
+        }
+        if (key == "selection") {
+            std::istringstream stream(value);
+            std::string name;
+            while (stream >> name) {
+                selectionNames.push_back(name);
+            }
+            selectionLine = lineNumber;
+            continue;
+        }
+
+        // A kind keyword starts a new body
+        static const char* KINDS[] = {"star", "planet", "moon", "comet"};
+        int kind = -1;
+        for (int k = 0; k < 4; k++) {
+            if (key == KINDS[k]) {
+                kind = k;
+            }
+        }
+        if (kind >= 0) {
+            if (value.empty() || value.find_first_of(" \t") != std::string::npos) {
+                fail("expected '" + key + " <name>' with a single-word name");
+            } else if (findName(value) >= 0) {
+                fail("duplicate body '" + value + "'");
+            } else {
+                BodyRecord body = {};
+                body.name = strings.add(value);
+                body.kind = uint32_t(kind);
+                body.parent = -1;
+                body.ephemeris = -1;
+                body.radius = 1.0f;
+                bodies.push_back(body);
+                names.push_back(value);
+                factCounts.push_back(0);
+            }
+            continue;
+        }
+
+        if (bodies.empty()) {
+            fail("'" + key + "' before the first body");
+            continue;
+        }
+        BodyRecord& body = bodies.back();
+
+        if (key == "parent") {
+            int parent = findName(value);
+            if (parent < 0) {
+                fail("unknown parent '" + value + "', parents must be declared first");
+            } else if (bodies[parent].kind == Comet) {
+                fail("comets cannot be parents");
+            }
+            body.parent = parent;
+        } else if (key == "texture") {
+            body.texture = strings.add(value);
+        } else if (key == "radius") {
+            if (!readFloats(value, &body.radius, 1) || body.radius < 0.0f) {
+                fail("expected 'radius <scale>'");
+            }
+        } else if (key == "orbit") {
+            float orbit[2];
+            if (!readFloats(value, orbit, 2)) {
+                fail("expected 'orbit <radius> <speed>'");
+            }
+            body.orbitRadius = orbit[0];
+            body.orbitSpeed = orbit[1];
+        } else if (key == "rotation") {
+            if (!readFloats(value, &body.rotationSpeed, 1)) {
+                fail("expected 'rotation <degrees per second>'");
+            }
+        } else if (key == "position") {
+            if (!readFloats(value, body.position, 3)) {
+                fail("expected 'position <x> <y> <z>'");
+            }
+        } else if (key == "compare") {
+            if (!readFloats(value, body.comparison, 3)) {
+                fail("expected 'compare <x> <y> <z>'");
+            }
+            body.flags |= HAS_COMPARISON;
+        } else if (key == "mass") {
+            if (!readFloats(value, &body.mass, 1) || body.mass < 0.0f) {
+                fail("expected 'mass <solar masses>'");
+            }
+        } else if (key == "eccentricity") {
+            if (!readFloats(value, &body.eccentricity, 1) || body.eccentricity < 0.0f || body.eccentricity >= 1.0f) {
+                fail("expected 'eccentricity <0 to 1>'");
+            }
+        } else if (key == "angle") {
+            if (!readFloats(value, &body.startAngle, 1)) {
+                fail("expected 'angle <degrees>'");
+            }
+        } else if (key == "ephemeris") {
+            for (int i = 0; i < KeplerianElements::BODY_COUNT; i++) {
+                if (value == EPHEMERIS_BODIES[i]) {
+                    body.ephemeris = i;
+                }
+            }
+            if (body.ephemeris < 0) {
+                fail("unknown ephemeris body '" + value + "'");
+            }
+        } else if (key == "rings") {
+            std::istringstream stream(value);
+            std::string texture, rest;
+            stream >> texture;
+            std::getline(stream, rest);
+            if (texture.empty() || !readFloats(rest, body.ring, 4)) {
+                fail("expected 'rings <texture> <inner radius> <outer radius> <tilt> <radial scale>'");
+            }
+            body.ringTexture = strings.add(texture);
+            body.flags |= HAS_RINGS;
+        } else if (key == "airless") {
+            if (!value.empty()) {
+                fail("'airless' takes no value");
+            }
+            body.flags |= AIRLESS;
+        } else if (key == "info") {
+            // Panel images from older scenes; the panels are drawn from the description and facts now
+            std::cerr << scenePath << ":" << lineNumber << ": 'info' is ignored, info panels are drawn from the text"
+                      << std::endl;
+        } else if (key == "description") {
+            body.description = strings.add(value);
+        } else if (key == "fact") {
+            int& facts = factCounts.back();
+            if (facts == FACT_COUNT) {
+                fail("at most " + std::to_string(FACT_COUNT) + " facts per body");
+            } else {
+                body.facts[facts++] = strings.add(value);
+            }
+        } else {
+            fail("unknown key '" + key + "'");
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+
+    // Cross-references resolved once every body is known
+    for (size_t i = 0; i < bodies.size(); i++) {
+        bool root = bodies[i].parent < 0;
+        if ((bodies[i].kind == Star || bodies[i].kind == Comet) != root) {
+            std::cerr << scenePath << ": " << names[i]
+                      << (root ? " needs a parent" : " cannot have a parent, stars and comets are roots") << std::endl;
+            return false;
+        }
+    }
+    if (!referenceName.empty()) {
+        header.referenceBody = findName(referenceName);
+        if (header.referenceBody < 0) {
+            std::cerr << scenePath << ":" << referenceLine << ": unknown body '" << referenceName << "'" << std::endl;
+            return false;
+        }
+    }
+    std::vector<uint32_t> selection;
+    for (const std::string& name : selectionNames) {
+        int index = findName(name);
+        if (index < 0) {
+            std::cerr << scenePath << ":" << selectionLine << ": unknown body '" << name << "'" << std::endl;
+            return false;
+        }
+        selection.push_back(uint32_t(index));
+    }
+
+    header.bodyCount = uint32_t(bodies.size());
+    header.selectionCount = uint32_t(selection.size());
+    header.stringBytes = uint32_t(strings.bytes.size());
+
+    // Write to a temporary file and rename, so a running instance never maps a half-written scene
+    std::string temporary = binaryPath + ".tmp";
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(binaryPath).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write compiled scene: " << temporary << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bodies.data()), bodies.size() * sizeof(BodyRecord));
+    file.write(reinterpret_cast<const char*>(selection.data()), selection.size() * sizeof(uint32_t));
+    file.write(strings.bytes.data(), strings.bytes.size());
+
+    file.close();
+    if (!file || std::rename(temporary.c_str(), binaryPath.c_str()) != 0) {
+        std::cerr << "Failed to write compiled scene: " << binaryPath << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string SceneFile::cachePath(const std::string& scenePath) {
+    return "cache/" + std::filesystem::path(scenePath).stem().string() + ".sscn";
+}
+
+const SceneFile::BodyRecord& SceneFile::body(uint32_t index) const {
+    return reinterpret_cast<const BodyRecord*>(data + sizeof(FileHeader))[index];
+}
+
+uint32_t SceneFile::selection(uint32_t index) const {
+    const unsigned char* table = data + sizeof(FileHeader) + size_t(bodyCount()) * sizeof(BodyRecord);
+    return reinterpret_cast<const uint32_t*>(table)[index];
+}
+
+const char* SceneFile::string(uint32_t offset) const {
+    return reinterpret_cast<const char*>(data + size - header().stringBytes + offset);
+}
+
+int SceneFile::find(const std::string& name) const {
+    for (uint32_t i = 0; i < bodyCount(); i++) {
+        if (name == string(body(i).name)) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+void SceneFile::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+        MemoryBudget::trackCpu(MemoryBudget::Caches, -int64_t(size));
+        data = nullptr;
+        size = 0;
+    }
+}
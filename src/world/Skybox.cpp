@@ -1,123 +1,90 @@
 #include "include/world/Skybox.hpp"
+#include "include/physics/ParallelFor.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include "include/utils/TextureUtils.hpp"
 #include <glm/gtc/type_ptr.hpp>
-#include <stb_image.h>
 #include <iostream>
 
 Skybox Skybox::create(const std::vector<std::string>& faces) {
     Skybox skybox;
 
-    float vertices[] = {
-        // Front face
-        -1.0f,  1.0f, -1.0f,
-        -1.0f, -1.0f, -1.0f,
-         1.0f, -1.0f, -1.0f,
-         1.0f, -1.0f, -1.0f,
-         1.0f,  1.0f, -1.0f,
-        -1.0f,  1.0f, -1.0f,
-
-        // Back face
-        -1.0f, -1.0f,  1.0f,
-        -1.0f,  1.0f,  1.0f,
-         1.0f,  1.0f,  1.0f,
-         1.0f,  1.0f,  1.0f,
-         1.0f, -1.0f,  1.0f,
-        -1.0f, -1.0f,  1.0f,
-
-        // Left face
-        -1.0f,  1.0f,  1.0f,
-        -1.0f, -1.0f,  1.0f,
-        -1.0f, -1.0f, -1.0f,
-        -1.0f, -1.0f, -1.0f,
-        -1.0f,  1.0f, -1.0f,
-        -1.0f,  1.0f,  1.0f,
-
-        // Right face
-         1.0f, -1.0f, -1.0f,
-         1.0f, -1.0f,  1.0f,
-         1.0f,  1.0f,  1.0f,
-         1.0f,  1.0f,  1.0f,
-         1.0f,  1.0f, -1.0f,
-         1.0f, -1.0f, -1.0f,
-
-        // Top face
-        -1.0f, -1.0f, -1.0f,
-        -1.0f, -1.0f,  1.0f,
-         1.0f, -1.0f,  1.0f,
-         1.0f, -1.0f,  1.0f,
-         1.0f, -1.0f, -1.0f,
-        -1.0f, -1.0f, -1.0f,
-
-        // Bottom face
-        -1.0f,  1.0f, -1.0f,
-         1.0f,  1.0f, -1.0f,
-         1.0f,  1.0f,  1.0f,
-         1.0f,  1.0f,  1.0f,
-        -1.0f,  1.0f,  1.0f,
-        -1.0f,  1.0f, -1.0f
-    };
-
-    glGenVertexArrays(1, &skybox.vao);
-    glGenBuffers(1, &skybox.vbo);
-
-    glBindVertexArray(skybox.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, skybox.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    // Core profile needs a bound VAO even though the triangle has no vertex attributes
+    skybox.vao = GlVertexArray::create();
 
     skybox.texture = loadCubemap(faces);
 
     return skybox;
 }
 
-unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces) {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+GlTexture Skybox::loadCubemap(const std::vector<std::string>& faces) {
+    struct Face {
+        unsigned char* pixels;
+        int width, height, channels;
+    };
 
-    int width, height, nrChannels;
+    // Decode the faces on worker threads (each is a multi-megapixel image), then upload them here on the GL thread
+    std::vector<Face> decoded(faces.size());
+    parallelFor(faces.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Face& face = decoded[i];
+            face.pixels = TextureUtils::decodeImage(faces[i].c_str(), &face.width, &face.height, &face.channels);
+        }
+    }, 1);
+
+    GlTexture texture = GlTexture::create();
+    RenderState::bindTexture(GL_TEXTURE_CUBE_MAP, texture);
+
+    size_t bytes = 0;
     for (unsigned int i = 0; i < faces.size(); i++) {
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data) {
+        const Face& face = decoded[i];
+        if (face.pixels) {
+            bytes += size_t(face.width) * face.height * 4;
+            GLenum format = (face.channels == 4) ? GL_RGBA : GL_RGB;
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 
                         0, 
                         GL_RGB, 
-                        width, 
-                        height, 
+                        face.width, 
+                        face.height, 
                         0, 
-                        GL_RGB, 
+                        format, 
                         GL_UNSIGNED_BYTE, 
-                        data);
-            stbi_image_free(data);
+                        face.pixels);
+            TextureUtils::freeImage(face.pixels);
         } else {
             std::cerr << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
-            stbi_image_free(data);
         }
     }
 
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    MemoryBudget::trackGpu(GlKind::Texture, texture, MemoryBudget::Textures, bytes);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-    return textureID;
+    return texture;
 }
 
 void Skybox::render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) const {
-    glDepthFunc(GL_LEQUAL);
-    glUseProgram(shader);
+    RenderState::setDepthTest(true);
+    RenderState::setDepthFunc(GL_LEQUAL);
+    RenderState::setCullFace(true);
+    RenderState::setBlend(false);
+    RenderState::useProgram(shader);
 
-    // Remove translation from view matrix for skybox
+    // Remove translation from view matrix for skybox, then invert to turn screen corners into view rays
     glm::mat4 skyboxView = glm::mat4(glm::mat3(viewMatrix));
+    glm::mat4 inverseViewProjection = glm::inverse(projectionMatrix * skyboxView);
 
-    glUniformMatrix4fv(glGetUniformLocation(shader, "view"), 1, GL_FALSE, glm::value_ptr(skyboxView));
-    glUniformMatrix4fv(glGetUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+    glUniformMatrix4fv(glGetUniformLocation(shader, "inverseViewProjection"),
+                       1,
+                       GL_FALSE,
+                       glm::value_ptr(inverseViewProjection));
 
-    glBindVertexArray(vao);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    RenderState::bindVertexArray(vao);
+    RenderState::bindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
 
-    glDepthFunc(GL_LESS);
+    RenderState::setDepthFunc(GL_LESS);
 }
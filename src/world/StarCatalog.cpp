@@ -0,0 +1,116 @@
+#include "include/world/StarCatalog.hpp"
+#include "include/utils/AssetPack.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace StarCatalog {
+
+namespace {
+const char MAGIC[4] = {'S', 'S', 'T', 'R'};
+
+uint8_t quantize(float value, float offset, float scale) {
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, std::round((value + offset) * scale))));
+}
+}
+
+StarRecord makeRecord(const glm::vec3& direction, float magnitude, float colorIndex) {
+    StarRecord record;
+    glm::vec3 unit = glm::normalize(direction);
+    for (int i = 0; i < 3; i++) {
+        record.direction[i] = static_cast<int16_t>(std::round(unit[i] * 32767.0f));
+    }
+    record.magnitude = quantize(magnitude, 2.0f, 20.0f);
+    record.colorIndex = quantize(colorIndex, 0.5f, 100.0f);
+    return record;
+}
+
+bool load(const std::string& path, std::vector<StarRecord>& stars) {
+    // Parsed in place from the pack; only a loose file is read into memory first
+    std::string_view bytes;
+    std::string loose;
+    if (!AssetPack::find(path, bytes)) {
+        if (!AssetPack::read(path, loose)) {
+            return false;
+        }
+        bytes = loose;
+    }
+
+    const size_t headerSize = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+    uint32_t version = 0, count = 0;
+    if (bytes.size() >= headerSize) {
+        memcpy(&version, bytes.data() + sizeof(MAGIC), sizeof(version));
+        memcpy(&count, bytes.data() + sizeof(MAGIC) + sizeof(version), sizeof(count));
+    }
+    if (bytes.size() < headerSize || memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+        std::cerr << "Invalid star catalog: " << path << std::endl;
+        return false;
+    }
+
+    if ((bytes.size() - headerSize) / sizeof(StarRecord) < count) {
+        std::cerr << "Truncated star catalog: " << path << std::endl;
+        stars.clear();
+        return false;
+    }
+    stars.resize(count);
+    memcpy(stars.data(), bytes.data() + headerSize, count * sizeof(StarRecord));
+    return true;
+}
+
+bool save(const std::string& path, const std::vector<StarRecord>& stars) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write star catalog: " << path << std::endl;
+        return false;
+    }
+
+    uint32_t count = static_cast<uint32_t>(stars.size());
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(stars.data()), count * sizeof(StarRecord));
+    return static_cast<bool>(file);
+}
+
+std::vector<StarRecord> generate(unsigned int count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::normal_distribution<float> colorDistribution(0.65f, 0.45f);
+
+    // Galactic plane normal, tilted against the orbital plane like the real Milky Way
+    const glm::vec3 galacticNormal = glm::normalize(glm::vec3(-0.87f, 0.48f, 0.11f));
+
+    // Star counts grow roughly as 10^(0.5 m) down to the naked-eye limit
+    const float minMagnitude = -1.5f;
+    const float maxMagnitude = 6.5f;
+    const float slope = 0.5f;
+    const float lowCount = std::pow(10.0f, slope * minMagnitude);
+    const float highCount = std::pow(10.0f, slope * maxMagnitude);
+
+    std::vector<StarRecord> stars;
+    stars.reserve(count);
+    for (unsigned int i = 0; i < count; i++) {
+        glm::vec3 direction(gaussian(rng), gaussian(rng), gaussian(rng));
+        if (glm::length(direction) < 1e-6f) {
+            direction = glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+        direction = glm::normalize(direction);
+
+        // Pull a share of the stars toward the galactic band
+        if (uniform(rng) < 0.4f) {
+            direction -= galacticNormal * (glm::dot(direction, galacticNormal) * 0.85f);
+            direction = glm::normalize(direction);
+        }
+
+        float magnitude = std::log10(lowCount + uniform(rng) * (highCount - lowCount)) / slope;
+        float colorIndex = std::min(2.0f, std::max(-0.4f, colorDistribution(rng)));
+        stars.push_back(makeRecord(direction, magnitude, colorIndex));
+    }
+    return stars;
+}
+
+}
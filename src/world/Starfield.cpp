@@ -0,0 +1,62 @@
+#include "include/world/Starfield.hpp"
+#include "include/world/StarCatalog.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+Starfield Starfield::create(const std::string& catalogPath) {
+    Starfield starfield;
+
+    std::vector<StarRecord> stars;
+    if (StarCatalog::load(catalogPath, stars)) {
+        std::cout << "Loaded star catalog: " << catalogPath << std::endl;
+    } else {
+        std::cout << "Star catalog not found at " << catalogPath << ", generating a synthetic sky" << std::endl;
+        stars = StarCatalog::generate(6000, 371);
+    }
+    starfield.starCount = stars.size();
+    std::cout << "Starfield: " << starfield.starCount << " stars, " << (stars.size() * sizeof(StarRecord)) / 1024
+              << " KB" << std::endl;
+
+    starfield.vao = GlVertexArray::create();
+    starfield.vbo = GlBuffer::create();
+
+    RenderState::bindVertexArray(starfield.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, starfield.vbo);
+    glBufferData(GL_ARRAY_BUFFER, stars.size() * sizeof(StarRecord), stars.data(), GL_STATIC_DRAW);
+    MemoryBudget::trackGpu(GlKind::Buffer, starfield.vbo, MemoryBudget::Geometry, stars.size() * sizeof(StarRecord));
+
+    // Direction as normalized shorts, magnitude and color index as raw bytes decoded in the shader
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(StarRecord), (void*)offsetof(StarRecord, direction));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(StarRecord), (void*)offsetof(StarRecord, magnitude));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(StarRecord), (void*)offsetof(StarRecord, colorIndex));
+    glEnableVertexAttribArray(2);
+
+    return starfield;
+}
+
+void Starfield::render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) const {
+    RenderState::setDepthTest(true);
+    RenderState::setDepthFunc(GL_LEQUAL);
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_ONE, GL_ONE); // Overlapping stars add up
+    RenderState::setProgramPointSize(true);    // The vertex shader sizes each sprite
+    RenderState::useProgram(shader);
+
+    // Stars are infinitely far away, only the camera rotation matters
+    glm::mat4 starView = glm::mat4(glm::mat3(viewMatrix));
+
+    glUniformMatrix4fv(glGetUniformLocation(shader, "view"), 1, GL_FALSE, glm::value_ptr(starView));
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+    glUniform1f(glGetUniformLocation(shader, "pointScale"), 1.0f); // Tuned for the 800x600 window
+
+    RenderState::bindVertexArray(vao);
+    glDrawArrays(GL_POINTS, 0, starCount);
+
+    RenderState::setDepthFunc(GL_LESS);
+}
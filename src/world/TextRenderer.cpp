@@ -0,0 +1,363 @@
+#include "include/world/TextRenderer.hpp"
+#include "include/utils/MemoryBudget.hpp"
+#include "include/utils/RenderState.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+// 5x7 font, one byte per column from left to right, bit 0 is the top row
+constexpr int GLYPH_WIDTH = 5;
+constexpr int GLYPH_HEIGHT = 7;
+constexpr uint8_t FONT[][GLYPH_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00}, // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+    {0x14, 0x08, 0x3E, 0x08, 0x14}, // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31}, // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+    {0x00, 0x7F, 0x41, 0x41, 0x00}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // backslash
+    {0x00, 0x41, 0x41, 0x7F, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, // `
+    {0x20, 0x54, 0x54, 0x54, 0x78}, // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+    {0x0C, 0x52, 0x52, 0x52, 0x3E}, // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+    {0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20}, // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // x
+    {0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // {
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // }
+    {0x08, 0x04, 0x08, 0x10, 0x08}, // ~
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // Solid block, sampled by addRect
+    {0x02, 0x05, 0x05, 0x02, 0x00}, // °
+    {0x11, 0x15, 0x1F, 0x00, 0x00}, // ³
+};
+constexpr int GLYPH_COUNT = sizeof(FONT) / sizeof(FONT[0]);
+constexpr int SOLID = 95;
+constexpr int DEGREE = 96;
+constexpr int CUBED = 97;
+constexpr int UNKNOWN = '?' - ' ';
+
+// Atlas cells: the glyph plus one font pixel of padding on each side, which is also the distance field's range
+constexpr int TEXELS_PER_PIXEL = 4;
+constexpr int PADDING = 1;
+constexpr int CELL_WIDTH = (GLYPH_WIDTH + 2 * PADDING) * TEXELS_PER_PIXEL;
+constexpr int CELL_HEIGHT = (GLYPH_HEIGHT + 2 * PADDING) * TEXELS_PER_PIXEL;
+constexpr int ATLAS_COLUMNS = 16;
+constexpr int ATLAS_ROWS = (GLYPH_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+constexpr int ATLAS_WIDTH = ATLAS_COLUMNS * CELL_WIDTH;
+constexpr int ATLAS_HEIGHT = ATLAS_ROWS * CELL_HEIGHT;
+
+// Layout in font pixels
+constexpr float ADVANCE = GLYPH_WIDTH + 1;
+constexpr float LINE_HEIGHT = GLYPH_HEIGHT + 3;
+
+bool pixelSet(int glyph, int x, int y) {
+    return x >= 0 && x < GLYPH_WIDTH && y >= 0 && y < GLYPH_HEIGHT && (FONT[glyph][x] >> y & 1);
+}
+
+// Signed distance in font pixels from p (glyph coordinates, origin at its top-left) to the glyph's outline,
+// negative inside. The glyph is a union of unit squares, so the distance is the nearest square of the other kind;
+// the ring of empty pixels around the glyph stands in for everything outside it.
+float glyphDistance(int glyph, glm::vec2 p) {
+    bool inside = pixelSet(glyph, int(std::floor(p.x)), int(std::floor(p.y)));
+    float nearest = float(PADDING + 1);
+    for (int y = -PADDING; y < GLYPH_HEIGHT + PADDING; y++) {
+        for (int x = -PADDING; x < GLYPH_WIDTH + PADDING; x++) {
+            if (pixelSet(glyph, x, y) == inside) {
+                continue;
+            }
+            glm::vec2 offset = glm::max(glm::abs(p - glm::vec2(x + 0.5f, y + 0.5f)) - 0.5f, 0.0f);
+            nearest = std::min(nearest, glm::length(offset));
+        }
+    }
+    return inside ? -nearest : nearest;
+}
+
+std::vector<uint8_t> buildAtlas() {
+    std::vector<uint8_t> texels(size_t(ATLAS_WIDTH) * ATLAS_HEIGHT, 0);
+    for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        int cellX = glyph % ATLAS_COLUMNS * CELL_WIDTH;
+        int cellY = glyph / ATLAS_COLUMNS * CELL_HEIGHT;
+        for (int y = 0; y < CELL_HEIGHT; y++) {
+            for (int x = 0; x < CELL_WIDTH; x++) {
+                glm::vec2 p = (glm::vec2(x, y) + 0.5f) / float(TEXELS_PER_PIXEL) - float(PADDING);
+                // 0.5 on the outline, 1 a padding width inside and 0 a padding width outside
+                float value = 0.5f - 0.5f * glyphDistance(glyph, p) / PADDING;
+                texels[size_t(cellY + y) * ATLAS_WIDTH + cellX + x] =
+                    uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+    return texels;
+}
+
+// Next glyph of UTF-8 text, advancing i past the whole character
+int nextGlyph(const std::string& text, size_t& i) {
+    unsigned char lead = text[i++];
+    if (lead < 0x80) {
+        return lead >= ' ' && lead < 0x7F ? lead - ' ' : UNKNOWN;
+    }
+    uint32_t codepoint = 0;
+    int continuation = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    codepoint = lead & (0x3F >> continuation);
+    for (int c = 0; c < continuation && i < text.size() && (text[i] & 0xC0) == 0x80; c++) {
+        codepoint = codepoint << 6 | (text[i++] & 0x3F);
+    }
+    if (codepoint == 0xB0) {
+        return DEGREE;
+    }
+    if (codepoint == 0xB3) {
+        return CUBED;
+    }
+    return UNKNOWN;
+}
+
+glm::vec2 cellTexCoord(int glyph, float x, float y) {
+    return glm::vec2(glyph % ATLAS_COLUMNS * CELL_WIDTH + x * TEXELS_PER_PIXEL,
+                     glyph / ATLAS_COLUMNS * CELL_HEIGHT + y * TEXELS_PER_PIXEL) /
+           glm::vec2(ATLAS_WIDTH, ATLAS_HEIGHT);
+}
+
+glm::u8vec4 packColor(const glm::vec4& color) {
+    return glm::u8vec4(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Two triangles covering [min, max] with the matching corners of [uvMin, uvMax]
+void addQuad(std::vector<TextRenderer::Vertex>& vertices, glm::vec2 min, glm::vec2 max, glm::vec2 uvMin,
+             glm::vec2 uvMax, glm::u8vec4 color) {
+    TextRenderer::Vertex topLeft{min, uvMin, color};
+    TextRenderer::Vertex topRight{{max.x, min.y}, {uvMax.x, uvMin.y}, color};
+    TextRenderer::Vertex bottomLeft{{min.x, max.y}, {uvMin.x, uvMax.y}, color};
+    TextRenderer::Vertex bottomRight{max, uvMax, color};
+    vertices.insert(vertices.end(), {topLeft, bottomLeft, bottomRight, bottomRight, topRight, topLeft});
+}
+}
+
+TextRenderer TextRenderer::create() {
+    TextRenderer text;
+    text.vertexCount = 0;
+    text.bufferBytes = 0;
+
+    std::vector<uint8_t> texels = buildAtlas();
+    text.atlas = GlTexture::create();
+    RenderState::bindTexture(GL_TEXTURE_2D, text.atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // No mipmaps: minified distances are still distances, the shader widens the edge instead
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    MemoryBudget::trackGpu(GlKind::Texture, text.atlas, MemoryBudget::Textures, texels.size());
+    std::cout << "Text atlas: " << GLYPH_COUNT << " glyphs, " << ATLAS_WIDTH << "x" << ATLAS_HEIGHT << " ("
+              << texels.size() / 1024 << " KB)" << std::endl;
+
+    text.vao = GlVertexArray::create();
+    text.vbo = GlBuffer::create();
+    RenderState::bindVertexArray(text.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, text.vbo);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(2);
+
+    return text;
+}
+
+float TextRenderer::advance(float size) {
+    return ADVANCE * size;
+}
+
+float TextRenderer::lineHeight(float size) {
+    return LINE_HEIGHT * size;
+}
+
+void TextRenderer::clear() {
+    vertices.clear();
+}
+
+size_t TextRenderer::addRect(float x, float y, float width, float height, const glm::vec4& color) {
+    size_t first = vertices.size();
+    // Every corner samples the middle of the solid block, deep inside its distance field
+    glm::vec2 solid = cellTexCoord(SOLID, PADDING + GLYPH_WIDTH * 0.5f, PADDING + GLYPH_HEIGHT * 0.5f);
+    addQuad(vertices, {x, y}, {x + width, y + height}, solid, solid, packColor(color));
+    return first;
+}
+
+void TextRenderer::resizeRect(size_t firstVertex, float width, float height) {
+    glm::vec2 min = vertices[firstVertex].position;
+    glm::vec2 max = min + glm::vec2(width, height);
+    // Same corner order as addQuad
+    vertices[firstVertex + 1].position = {min.x, max.y};
+    vertices[firstVertex + 2].position = max;
+    vertices[firstVertex + 3].position = max;
+    vertices[firstVertex + 4].position = {max.x, min.y};
+}
+
+float TextRenderer::addText(const std::string& text, float x, float y, float size, float maxWidth,
+                            const glm::vec4& color) {
+    glm::u8vec4 packed = packColor(color);
+    size_t columns = std::max(1, int(maxWidth / advance(size)));
+    // Quads extend over the padding, so the distance field fades out around the glyph instead of being cut off
+    glm::vec2 quadSize = glm::vec2(GLYPH_WIDTH + 2 * PADDING, GLYPH_HEIGHT + 2 * PADDING) * size;
+    glm::vec2 uvSize = cellTexCoord(0, GLYPH_WIDTH + 2 * PADDING, GLYPH_HEIGHT + 2 * PADDING);
+
+    // Greedy word wrap over glyph indices, a word longer than a line is split
+    std::vector<int> word;
+    size_t column = 0;
+    float lineY = y;
+    auto flushWord = [&]() {
+        if (word.empty()) {
+            return;
+        }
+        if (column > 0 && column + 1 + word.size() > columns) {
+            column = 0;
+            lineY += lineHeight(size);
+        } else if (column > 0) {
+            column++; // The space before the word
+        }
+        for (int glyph : word) {
+            if (column >= columns) {
+                column = 0;
+                lineY += lineHeight(size);
+            }
+            glm::vec2 min = glm::vec2(x + column * advance(size), lineY) - float(PADDING) * size;
+            glm::vec2 uvMin = cellTexCoord(glyph, 0.0f, 0.0f);
+            addQuad(vertices, min, min + quadSize, uvMin, uvMin + uvSize, packed);
+            column++;
+        }
+        word.clear();
+    };
+
+    for (size_t i = 0; i < text.size();) {
+        if (text[i] == '\n') {
+            flushWord();
+            column = 0;
+            lineY += lineHeight(size);
+            i++;
+        } else if (text[i] == ' ') {
+            flushWord();
+            i++;
+        } else {
+            word.push_back(nextGlyph(text, i));
+        }
+    }
+    flushWord();
+    return lineY + lineHeight(size);
+}
+
+void TextRenderer::upload() {
+    vertexCount = GLsizei(vertices.size());
+    size_t bytes = vertices.size() * sizeof(Vertex);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (bytes > bufferBytes) {
+        // Grow with headroom so panels of similar length reuse the allocation
+        bufferBytes = std::max(bytes, bufferBytes * 2);
+        glBufferData(GL_ARRAY_BUFFER, bufferBytes, nullptr, GL_DYNAMIC_DRAW);
+        MemoryBudget::trackGpu(GlKind::Buffer, vbo, MemoryBudget::Geometry, bufferBytes);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+}
+
+void TextRenderer::render(GLuint shader, const glm::mat4& projection, const glm::vec2& origin, float alpha) const {
+    if (vertexCount == 0) {
+        return;
+    }
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::setDepthTest(false);
+    RenderState::useProgram(shader);
+
+    RenderState::bindTexture(GL_TEXTURE_2D, atlas);
+    glUniform1i(glGetUniformLocation(shader, "atlas"), 0);
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform2f(glGetUniformLocation(shader, "origin"), origin.x, origin.y);
+    glUniform1f(glGetUniformLocation(shader, "alpha"), alpha);
+
+    RenderState::bindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+}
@@ -0,0 +1,65 @@
+#include "include/world/TimeController.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+double TimeController::advance(double frameDt,
+                               const std::function<double(double)>& stepSize,
+                               const std::function<void(double)>& step) {
+    double requested = frameDt * timeSpeed;
+    lastSubsteps = 0;
+    if (requested == 0.0) {
+        limited = false;
+        effectiveSpeed = frameDt > 0.0 ? 0.0 : effectiveSpeed;
+        return 0.0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    double direction = requested > 0.0 ? 1.0 : -1.0;
+    double remaining = std::abs(requested);
+    double covered = 0.0;
+
+    // Stop once the leftover is only rounding noise
+    while (remaining > std::abs(requested) * 1e-12) {
+        double h = std::min(stepSize(remaining), remaining);
+        if (!(h > 0.0)) {
+            h = remaining;
+        }
+        step(direction * h);
+        covered += h;
+        remaining -= h;
+        lastSubsteps++;
+
+        // Checking the clock every step would cost more than the cheap substeps themselves
+        if (lastSubsteps % 16 == 0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > budgetSeconds) {
+            break;
+        }
+    }
+
+    limited = remaining > std::abs(requested) * 1e-12;
+    double achieved = direction * covered;
+    simTime += achieved;
+    effectiveSpeed = achieved / frameDt;
+    return achieved;
+}
+
+void TimeController::faster() {
+    double magnitude = std::abs(timeSpeed);
+    magnitude = magnitude >= 10.0 ? magnitude * 10.0 : std::min(magnitude * 1.5, 10.0);
+    timeSpeed = std::copysign(std::min(magnitude, MAX_SPEED), timeSpeed);
+}
+
+void TimeController::slower() {
+    double magnitude = std::abs(timeSpeed);
+    magnitude = magnitude > 10.0 ? std::max(magnitude / 10.0, 10.0) : magnitude / 1.5;
+    timeSpeed = std::copysign(magnitude, timeSpeed);
+}
+
+void TimeController::reverse() {
+    timeSpeed = -timeSpeed;
+}
+
+void TimeController::reset() {
+    timeSpeed = 1.0;
+}
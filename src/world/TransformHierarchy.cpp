@@ -0,0 +1,100 @@
+#include "include/world/TransformHierarchy.hpp"
+#include <algorithm>
+#include <cmath>
+
+int TransformHierarchy::add(int parentNode, unsigned char inheritFlags) {
+    int node = static_cast<int>(size());
+    parent.push_back(parentNode < node ? parentNode : NO_PARENT);
+    inherit.push_back(inheritFlags);
+    translation.push_back(glm::dvec3(0.0));
+    spin.push_back(0.0f);
+    tilt.push_back(0.0f);
+    scale.push_back(glm::vec3(1.0f));
+    dirty.push_back(1);
+
+    worldRotation.push_back(glm::mat3(1.0f));
+    worldScale.push_back(glm::vec3(1.0f));
+    worldTranslation.push_back(glm::dvec3(0.0));
+    return node;
+}
+
+void TransformHierarchy::setTranslation(int node, const glm::dvec3& value) {
+    if (translation[node] != value) {
+        translation[node] = value;
+        dirty[node] = 1;
+    }
+}
+
+void TransformHierarchy::setRotation(int node, float spinDegrees, float tiltDegrees) {
+    if (spin[node] != spinDegrees || tilt[node] != tiltDegrees) {
+        spin[node] = spinDegrees;
+        tilt[node] = tiltDegrees;
+        dirty[node] = 1;
+    }
+}
+
+void TransformHierarchy::setScale(int node, const glm::vec3& value) {
+    if (scale[node] != value) {
+        scale[node] = value;
+        dirty[node] = 1;
+    }
+}
+
+void TransformHierarchy::update() {
+    lastUpdated = 0;
+    const size_t count = size();
+
+    for (size_t i = 0; i < count; i++) {
+        int p = parent[i];
+        // Parents come first, so dirty[p] already says whether the parent moved in this pass
+        if (!dirty[i] && (p == NO_PARENT || !dirty[p])) {
+            continue;
+        }
+        dirty[i] = 1;
+        lastUpdated++;
+
+        glm::mat3 localRotation = rotation(spin[i], tilt[i]);
+        if (p == NO_PARENT) {
+            worldRotation[i] = localRotation;
+            worldScale[i] = scale[i];
+            worldTranslation[i] = translation[i];
+            continue;
+        }
+
+        const glm::mat3& parentRotation = worldRotation[p];
+        const glm::dvec3& t = translation[i];
+        if (inherit[i] & INHERIT_ROTATION) {
+            worldRotation[i] = parentRotation * localRotation;
+            // Offset rotated in double, large orbits keep their precision
+            worldTranslation[i] = worldTranslation[p] + glm::dvec3(parentRotation[0]) * t.x +
+                                  glm::dvec3(parentRotation[1]) * t.y + glm::dvec3(parentRotation[2]) * t.z;
+        } else {
+            worldRotation[i] = localRotation;
+            worldTranslation[i] = worldTranslation[p] + t;
+        }
+        worldScale[i] = (inherit[i] & INHERIT_SCALE) ? worldScale[p] * scale[i] : scale[i];
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+glm::mat4 TransformHierarchy::renderMatrix(int node, const FloatingOrigin& origin) const {
+    const glm::mat3& r = worldRotation[node];
+    const glm::vec3& s = worldScale[node];
+    glm::mat4 m(1.0f);
+    m[0] = glm::vec4(r[0] * s.x, 0.0f);
+    m[1] = glm::vec4(r[1] * s.y, 0.0f);
+    m[2] = glm::vec4(r[2] * s.z, 0.0f);
+    m[3] = glm::vec4(origin.toRender(worldTranslation[node]), 1.0f);
+    return m;
+}
+
+glm::mat3 TransformHierarchy::rotation(float spinDegrees, float tiltDegrees) {
+    float a = glm::radians(spinDegrees);
+    float t = glm::radians(tiltDegrees);
+    float ca = std::cos(a), sa = std::sin(a);
+    float ct = std::cos(t), st = std::sin(t);
+    return glm::mat3(glm::vec3(ca, 0.0f, -sa),
+                     glm::vec3(sa * st, ct, ca * st),
+                     glm::vec3(sa * ct, -st, ca * ct));
+}
@@ -1,4 +1,5 @@
 #include "include/world/Window.hpp"
+#include "include/utils/RenderState.hpp"
 
 GLFWwindow* Window::initializeGLFW() {
     if (!glfwInit()) {
@@ -10,6 +11,9 @@ GLFWwindow* Window::initializeGLFW() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#ifndef NDEBUG
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
 
     GLFWwindow* window = glfwCreateWindow(800, 600, "Comp371 - Project Assignment", NULL, NULL);
 
@@ -31,5 +35,9 @@ bool Window::initializeOpenGL() {
         std::cerr << "Failed to initialize GLEW" << std::endl;
         return false;
     }
+
+    // glewInit can leave a spurious GL_INVALID_ENUM behind on core profiles
+    glGetError();
+    RenderState::installDebugCallback();
     return true;
 }
@@ -0,0 +1,51 @@
+// Compiles a text scene description into the memory-mapped binary read at startup (see SceneFile.hpp).
+// The simulator does this itself whenever the text is newer than the binary; this tool is for shipping
+// precompiled scenes and for checking a scene for errors without opening a window.
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -I. -Iinclude tools/compile_scene.cpp src/world/SceneFile.cpp src/utils/MemoryBudget.cpp -o compile_scene
+//
+// Usage:
+//   compile_scene <input.scene> [output.sscn, default cache/<name>.sscn]
+#include "include/world/SceneFile.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+const char* KIND_NAMES[] = {"star", "planet", "moon", "comet"};
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.scene> [output.sscn]" << std::endl;
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = argc == 3 ? argv[2] : SceneFile::cachePath(input);
+
+    if (!SceneFile::compile(input, output)) {
+        return 1;
+    }
+
+    // Map the result the way the simulator does and list what it holds
+    auto start = std::chrono::steady_clock::now();
+    SceneFile scene = SceneFile::load(input, output);
+    double loadMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (!scene.valid()) {
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < scene.bodyCount(); i++) {
+        const SceneFile::BodyRecord& body = scene.body(i);
+        std::cout << "  " << KIND_NAMES[body.kind] << " " << scene.string(body.name);
+        if (body.parent >= 0) {
+            std::cout << " (orbits " << scene.string(scene.body(body.parent).name) << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Wrote " << output << ": " << scene.bodyCount() << " bodies, " << scene.size << " bytes, mapped in "
+              << loadMicroseconds << " us" << std::endl;
+    scene.close();
+    return 0;
+}
@@ -0,0 +1,147 @@
+// Times image decoding over the texture tree with every decoder backend that takes each file, plus the
+// parallel decode TextureCache::preload runs at startup, to see what images cost and which backend to ship.
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -pthread -I. -Iinclude tools/decode_bench.cpp src/utils/ImageDecoder.cpp src/physics/ParallelFor.cpp -o decode_bench
+// With libjpeg-turbo (Homebrew jpeg-turbo), add:
+//   -DSOLARSCOPE_TURBOJPEG -I/opt/homebrew/opt/jpeg-turbo/include -L/opt/homebrew/opt/jpeg-turbo/lib -lturbojpeg
+// With libspng (Homebrew libspng), add:
+//   -DSOLARSCOPE_SPNG -I/opt/homebrew/include -L/opt/homebrew/lib -lspng
+//
+// Usage:
+//   decode_bench [directory, default textures] [repetitions, default 3]
+//
+// Files are read into memory first, so only decoding is timed; each time is the best of the repetitions.
+#include "include/physics/ParallelFor.hpp"
+#include "include/utils/ImageDecoder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+struct EncodedImage {
+    std::string path;
+    std::string bytes;
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Best-of-N decode time of one image with one backend, -1 when the backend fails on it
+double timeDecode(const ImageDecoder& decoder, const EncodedImage& image, int repetitions, double& megapixels) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(image.bytes.data());
+    double best = -1.0;
+    for (int r = 0; r < repetitions; r++) {
+        int width = 0, height = 0, channels = 0;
+        auto start = std::chrono::steady_clock::now();
+        unsigned char* pixels = decoder.decode(data, image.bytes.size(), &width, &height, &channels);
+        double elapsed = seconds(start);
+        if (!pixels) {
+            return -1.0;
+        }
+        std::free(pixels);
+        megapixels = double(width) * height / 1e6;
+        best = best < 0.0 ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "textures";
+    int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+    std::vector<EncodedImage> images;
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (it->is_regular_file() && (extension == ".jpg" || extension == ".jpeg" || extension == ".png")) {
+            std::ifstream file(it->path(), std::ios::binary);
+            images.push_back({it->path().generic_string(),
+                              std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>())});
+        }
+    }
+    if (error || images.empty()) {
+        std::cerr << "No images found in " << directory << std::endl;
+        return 1;
+    }
+    std::sort(images.begin(), images.end(), [](const EncodedImage& a, const EncodedImage& b) { return a.path < b.path; });
+
+    const std::vector<ImageDecoder>& decoders = ImageDecoder::all();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(48) << "image" << std::right << std::setw(8) << "KB" << std::setw(8) << "MP";
+    for (const ImageDecoder& decoder : decoders) {
+        std::cout << std::setw(16) << (std::string(decoder.name) + " ms");
+    }
+    std::cout << std::endl;
+
+    // Per backend: total time over the images it decoded
+    std::vector<double> totals(decoders.size(), 0.0);
+    double chainTotal = 0.0, totalMegapixels = 0.0;
+    for (const EncodedImage& image : images) {
+        double megapixels = 0.0;
+        std::vector<double> times(decoders.size(), -1.0);
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(image.bytes.data());
+        for (size_t d = 0; d < decoders.size(); d++) {
+            if (decoders[d].accepts(data, image.bytes.size())) {
+                times[d] = timeDecode(decoders[d], image, repetitions, megapixels);
+            }
+        }
+        // decodeAny takes the first backend that succeeds
+        for (double time : times) {
+            if (time >= 0.0) {
+                chainTotal += time;
+                break;
+            }
+        }
+        totalMegapixels += megapixels;
+
+        std::cout << std::left << std::setw(48) << image.path << std::right << std::setw(8)
+                  << image.bytes.size() / 1024.0 << std::setw(8) << megapixels;
+        for (size_t d = 0; d < decoders.size(); d++) {
+            if (times[d] >= 0.0) {
+                totals[d] += times[d];
+                std::cout << std::setw(16) << times[d] * 1000.0;
+            } else {
+                std::cout << std::setw(16) << "-";
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "\n" << images.size() << " images, " << totalMegapixels << " MP" << std::endl;
+    for (size_t d = 0; d < decoders.size(); d++) {
+        std::cout << std::left << std::setw(16) << decoders[d].name << std::right << std::setw(10)
+                  << totals[d] * 1000.0 << " ms over the images it takes" << std::endl;
+    }
+    std::cout << std::left << std::setw(16) << "decodeAny" << std::right << std::setw(10) << chainTotal * 1000.0
+              << " ms, " << totalMegapixels / std::max(chainTotal, 1e-9) << " MP/s on one thread" << std::endl;
+
+    // What startup sees: every image decoded at once, one per thread
+    double parallelBest = -1.0;
+    for (int r = 0; r < repetitions; r++) {
+        auto start = std::chrono::steady_clock::now();
+        parallelFor(images.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                int width = 0, height = 0, channels = 0;
+                std::free(ImageDecoder::decodeAny(reinterpret_cast<const unsigned char*>(images[i].bytes.data()),
+                                                  images[i].bytes.size(), &width, &height, &channels));
+            }
+        }, 1);
+        double elapsed = seconds(start);
+        parallelBest = parallelBest < 0.0 ? elapsed : std::min(parallelBest, elapsed);
+    }
+    std::cout << std::left << std::setw(16) << "parallel" << std::right << std::setw(10) << parallelBest * 1000.0
+              << " ms on " << std::max(1u, std::thread::hardware_concurrency()) << " threads" << std::endl;
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Generates src/utils/EmbeddedShaders.cpp, the GLSL sources compiled into the simulator (see EmbeddedShaders.hpp),
+// so the executable no longer needs shaders/ next to its working directory.
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 tools/embed_shaders.cpp -o embed_shaders
+//
+// Usage (from the repository root before building; the build task in run/tasks.json does this):
+//   embed_shaders [shader directory, default shaders] [output, default src/utils/EmbeddedShaders.cpp]
+//
+// The output is only rewritten when its contents change, so an unchanged tree does not rebuild.
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "shaders";
+    std::string output = argc > 2 ? argv[2] : "src/utils/EmbeddedShaders.cpp";
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".glsl") {
+            paths.push_back(it->path().lexically_normal().generic_string());
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to read directory " << directory << ": " << error.message() << std::endl;
+        return 1;
+    }
+    // Sorted, so EmbeddedShaders::SOURCES can be binary searched
+    std::sort(paths.begin(), paths.end());
+
+    std::ostringstream code;
+    code << "// Generated by tools/embed_shaders.cpp from " << directory << "/, do not edit.\n"
+         << "#include \"include/utils/EmbeddedShaders.hpp\"\n"
+         << "\n"
+         << "namespace EmbeddedShaders {\n"
+         << "\n"
+         << "const Source SOURCES[] = {\n";
+    for (const std::string& path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!file || text.find(")glsl\"") != std::string::npos) {
+            std::cerr << "Cannot embed " << path << (file ? ": contains )glsl\"" : ": unreadable") << std::endl;
+            return 1;
+        }
+        code << "    {\"" << path << "\", R\"glsl(" << text << ")glsl\"},\n";
+    }
+    code << "};\n"
+         << "\n"
+         << "const size_t SOURCE_COUNT = sizeof(SOURCES) / sizeof(SOURCES[0]);\n"
+         << "\n"
+         << "}\n";
+
+    std::ifstream existing(output, std::ios::binary);
+    std::string previous((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+    if (previous == code.str()) {
+        std::cout << output << " is up to date (" << paths.size() << " shaders)" << std::endl;
+        return 0;
+    }
+    std::ofstream file(output, std::ios::binary);
+    file << code.str();
+    if (!file) {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Embedded " << paths.size() << " shaders into " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Bundles the runtime assets into the single memory-mapped pack the simulator reads at startup
+// (see AssetPack.hpp), so launching opens one file instead of every shader, texture and model.
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -I. -Iinclude tools/make_asset_pack.cpp src/utils/AssetPack.cpp src/utils/MemoryBudget.cpp -o make_asset_pack
+//
+// Usage (from the repository root, so assets are stored under the paths the simulator asks for):
+//   make_asset_pack [output, default assets.pack] [directories, default shaders textures models]
+//
+// The pack takes precedence over loose files, so rebuild it after editing an asset.
+#include "include/utils/AssetPack.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::string output = argc > 1 ? argv[1] : "assets.pack";
+    std::vector<std::string> directories;
+    for (int i = 2; i < argc; i++) {
+        directories.push_back(argv[i]);
+    }
+    if (directories.empty()) {
+        directories = {"shaders", "textures", "models"};
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> paths;
+    uintmax_t bytes = 0;
+    for (const std::string& directory : directories) {
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+             !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+            // Dot files are editor and OS clutter (.DS_Store), never assets
+            if (it->path().filename().string().rfind('.', 0) == 0) {
+                if (it->is_directory()) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            if (it->is_regular_file()) {
+                paths.push_back(it->path().generic_string());
+                bytes += it->file_size();
+            }
+        }
+        if (error) {
+            std::cerr << "Failed to read directory " << directory << ": " << error.message() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!AssetPack::write(output, paths)) {
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Packed " << paths.size() << " assets (" << bytes / (1024 * 1024) << " MB) into " << output
+              << " in " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Converts a CSV star catalog into the binary format read by Starfield (see StarCatalog.hpp).
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -I. -Iinclude tools/make_star_catalog.cpp src/world/StarCatalog.cpp src/utils/AssetPack.cpp src/utils/MemoryBudget.cpp -o make_star_catalog
+//
+// Usage:
+//   make_star_catalog <input.csv> <output.bin> [limiting magnitude, default 6.5]
+//   make_star_catalog --synthetic <count> <output.bin>
+//
+// The CSV needs a header row with "ra" (hours), "dec" (degrees), "mag" and "ci" (B-V) columns,
+// which matches the HYG database export. The bundled textures/stars/bright_stars.bin is built from
+// tools/bright_stars.csv (the brightest naked-eye stars, J2000 positions):
+//   make_star_catalog tools/bright_stars.csv textures/stars/bright_stars.bin
+#include "include/world/StarCatalog.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    bool quoted = false;
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ',' && !quoted) {
+            fields.push_back(field);
+            field.clear();
+        } else if (c != '\r') {
+            field += c;
+        }
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+int findColumn(const std::vector<std::string>& header, const std::string& name) {
+    for (size_t i = 0; i < header.size(); i++) {
+        if (header[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Equatorial RA/Dec to the scene frame: ecliptic plane is XZ, ecliptic north is +Y
+glm::vec3 equatorialToScene(double raHours, double decDegrees) {
+    const double degToRad = 3.14159265358979323846 / 180.0;
+    const double obliquity = 23.4393 * degToRad;
+    double ra = raHours * 15.0 * degToRad;
+    double dec = decDegrees * degToRad;
+
+    double x = cos(dec) * cos(ra);
+    double y = cos(dec) * sin(ra);
+    double z = sin(dec);
+
+    // Rotate about the equinox axis into ecliptic coordinates
+    double yEcliptic = y * cos(obliquity) + z * sin(obliquity);
+    double zEcliptic = -y * sin(obliquity) + z * cos(obliquity);
+
+    return glm::vec3(static_cast<float>(x), static_cast<float>(zEcliptic), static_cast<float>(-yEcliptic));
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && std::string(argv[1]) == "--synthetic") {
+        std::vector<StarRecord> stars = StarCatalog::generate(std::atoi(argv[2]), 371);
+        if (!StarCatalog::save(argv[3], stars)) {
+            return 1;
+        }
+        std::cout << "Wrote " << stars.size() << " synthetic stars to " << argv[3] << std::endl;
+        return 0;
+    }
+
+    if (argc < 3) {
+        std::cerr << "Usage: make_star_catalog <input.csv> <output.bin> [limiting magnitude]" << std::endl;
+        std::cerr << "       make_star_catalog --synthetic <count> <output.bin>" << std::endl;
+        return 1;
+    }
+
+    double limitingMagnitude = argc > 3 ? std::atof(argv[3]) : 6.5;
+
+    std::ifstream input(argv[1]);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::string line;
+    std::getline(input, line);
+    std::vector<std::string> header = splitCsvLine(line);
+    int raColumn = findColumn(header, "ra");
+    int decColumn = findColumn(header, "dec");
+    int magColumn = findColumn(header, "mag");
+    int ciColumn = findColumn(header, "ci");
+    if (raColumn < 0 || decColumn < 0 || magColumn < 0) {
+        std::cerr << "CSV header must contain ra, dec and mag columns" << std::endl;
+        return 1;
+    }
+
+    std::vector<StarRecord> stars;
+    while (std::getline(input, line)) {
+        std::vector<std::string> fields = splitCsvLine(line);
+        if (static_cast<int>(fields.size()) <= std::max(raColumn, std::max(decColumn, magColumn))) {
+            continue;
+        }
+
+        double magnitude = std::atof(fields[magColumn].c_str());
+        if (fields[magColumn].empty() || magnitude > limitingMagnitude || magnitude < -2.0) {
+            continue; // Skips the Sun (mag -26.7) and anything too faint
+        }
+
+        double colorIndex = 0.65;
+        if (ciColumn >= 0 && ciColumn < static_cast<int>(fields.size()) && !fields[ciColumn].empty()) {
+            colorIndex = std::atof(fields[ciColumn].c_str());
+        }
+
+        glm::vec3 direction =
+            equatorialToScene(std::atof(fields[raColumn].c_str()), std::atof(fields[decColumn].c_str()));
+        stars.push_back(StarCatalog::makeRecord(direction, static_cast<float>(magnitude), static_cast<float>(colorIndex)));
+    }
+
+    if (!StarCatalog::save(argv[2], stars)) {
+        return 1;
+    }
+    std::cout << "Wrote " << stars.size() << " stars brighter than magnitude " << limitingMagnitude << " to "
+              << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Benchmarks the gravity solvers on a Plummer sphere:
+// - Barnes-Hut build/force time and force error against direct summation, for several opening angles
+// - Throughput of the vectorized DirectSummation kernel in interactions per second
+// - Energy drift of the leapfrog and Yoshida integrators on an eccentric two-body orbit
+//
+// Build from the repository root (-march=native enables the AVX2/AVX-512 kernels on x86):
+//   g++ -std=c++20 -O2 -march=native -pthread -I. -Iinclude tools/nbody_bench.cpp src/physics/*.cpp -o nbody_bench
+//
+// Usage:
+//   nbody_bench [particles, default 100000] [reference samples, default 1000]
+//
+// Direct summation is O(N^2), so the reference forces are computed for a random sample of particles
+// and the full direct cost is extrapolated from that sample.
+#include "include/physics/BarnesHut.hpp"
+#include "include/physics/DirectSummation.hpp"
+#include "include/physics/NBodySystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+// Plummer model with unit total mass and scale radius, truncated at 10 scale radii
+NBodySystem makePlummerSphere(size_t count, unsigned int seed) {
+    NBodySystem system;
+    system.softening = 0.01;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (size_t i = 0; i < count; i++) {
+        double radius;
+        do {
+            radius = 1.0 / std::sqrt(std::pow(uniform(rng), -2.0 / 3.0) - 1.0);
+        } while (radius > 10.0);
+        double cosTheta = 2.0 * uniform(rng) - 1.0;
+        double sinTheta = std::sqrt(1.0 - cosTheta * cosTheta);
+        double phi = 2.0 * M_PI * uniform(rng);
+        glm::dvec3 position(radius * sinTheta * std::cos(phi), radius * sinTheta * std::sin(phi), radius * cosTheta);
+        system.add(position, glm::dvec3(0.0), 1.0 / count);
+    }
+    return system;
+}
+
+// Exact softened acceleration on one particle
+void directAcceleration(const NBodySystem& system, size_t i, double& ax, double& ay, double& az) {
+    double softening2 = system.softening * system.softening;
+    ax = ay = az = 0.0;
+    for (size_t j = 0; j < system.size(); j++) {
+        if (j == i) {
+            continue;
+        }
+        double dx = system.x[j] - system.x[i];
+        double dy = system.y[j] - system.y[i];
+        double dz = system.z[j] - system.z[i];
+        double invR = 1.0 / std::sqrt(dx * dx + dy * dy + dz * dz + softening2);
+        double f = system.mass[j] * invR * invR * invR;
+        ax += f * dx;
+        ay += f * dy;
+        az += f * dz;
+    }
+    ax *= system.gravitationalConstant;
+    ay *= system.gravitationalConstant;
+    az *= system.gravitationalConstant;
+}
+
+// Relative energy error after integrating a two-body orbit (e = 0.5) for the given number of periods
+template <typename Solver>
+double twoBodyDrift(Solver& solver, int periods, int stepsPerPeriod) {
+    NBodySystem system;
+    double e = 0.5;
+    // Unit semi-major axis and G(M + m) = 1, start at periapsis
+    double periapsis = 1.0 - e;
+    double speed = std::sqrt((1.0 + e) / periapsis);
+    system.add(glm::dvec3(0.0), glm::dvec3(0.0), 1.0 - 1e-3);
+    system.add(glm::dvec3(periapsis, 0.0, 0.0), glm::dvec3(0.0, speed, 0.0), 1e-3);
+    system.removeMomentum();
+
+    double initial = system.totalEnergy();
+    double dt = 2.0 * M_PI / stepsPerPeriod;
+    for (int i = 0; i < periods * stepsPerPeriod; i++) {
+        solver.step(system, dt);
+    }
+    return std::abs((system.totalEnergy() - initial) / initial);
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t sampleCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    sampleCount = std::min(sampleCount, count);
+
+    NBodySystem system = makePlummerSphere(count, 42);
+    std::printf("Plummer sphere: %zu particles\n", count);
+
+    // Reference forces for a random sample
+    std::mt19937 rng(7);
+    std::vector<size_t> samples(sampleCount);
+    for (size_t& sample : samples) {
+        sample = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    }
+    std::vector<double> refX(sampleCount), refY(sampleCount), refZ(sampleCount);
+    auto directStart = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < sampleCount; k++) {
+        directAcceleration(system, samples[k], refX[k], refY[k], refZ[k]);
+    }
+    double directSample = std::chrono::duration<double>(std::chrono::steady_clock::now() - directStart).count();
+    double directFull = directSample * count / std::max<size_t>(sampleCount, 1);
+    std::printf("Direct summation (single thread): %.3f s for %zu particles, ~%.2f s extrapolated for all\n",
+                directSample, sampleCount, directFull);
+
+    std::printf("%6s %10s %10s %12s %12s %12s %9s\n", "theta", "build ms", "force ms", "nodes", "rms error",
+                "max error", "speedup");
+    for (double theta : {0.3, 0.5, 0.7, 1.0}) {
+        BarnesHut solver(theta);
+        solver.computeAccelerations(system);
+        // Second run so thread start-up and first-touch allocation are not counted
+        solver.computeAccelerations(system);
+
+        double sumError2 = 0.0;
+        double maxError = 0.0;
+        for (size_t k = 0; k < sampleCount; k++) {
+            size_t i = samples[k];
+            double ex = system.ax[i] - refX[k];
+            double ey = system.ay[i] - refY[k];
+            double ez = system.az[i] - refZ[k];
+            double reference = std::sqrt(refX[k] * refX[k] + refY[k] * refY[k] + refZ[k] * refZ[k]);
+            double error = std::sqrt(ex * ex + ey * ey + ez * ez) / std::max(reference, 1e-30);
+            sumError2 += error * error;
+            maxError = std::max(maxError, error);
+        }
+        double rmsError = std::sqrt(sumError2 / std::max<size_t>(sampleCount, 1));
+        double total = solver.lastStats.buildSeconds + solver.lastStats.forceSeconds;
+
+        std::printf("%6.2f %10.2f %10.2f %12zu %12.2e %12.2e %8.1fx\n", theta, solver.lastStats.buildSeconds * 1000.0,
+                    solver.lastStats.forceSeconds * 1000.0, solver.lastStats.nodeCount, rmsError, maxError,
+                    directFull / total);
+    }
+
+    // Vectorized direct kernel on a subset small enough for O(N^2)
+    size_t directCount = std::min<size_t>(count, 8192);
+    NBodySystem subset = makePlummerSphere(directCount, 42);
+    DirectSummation direct;
+    direct.computeAccelerations(subset);
+    direct.computeAccelerations(subset);
+    double maxDirectError = 0.0;
+    for (size_t i = 0; i < directCount; i += std::max<size_t>(1, directCount / 100)) {
+        double ax, ay, az;
+        directAcceleration(subset, i, ax, ay, az);
+        double reference = std::sqrt(ax * ax + ay * ay + az * az);
+        double ex = subset.ax[i] - ax, ey = subset.ay[i] - ay, ez = subset.az[i] - az;
+        maxDirectError = std::max(maxDirectError, std::sqrt(ex * ex + ey * ey + ez * ez) / std::max(reference, 1e-30));
+    }
+    std::printf("DirectSummation (%s): %zu particles in %.2f ms, %.3g interactions/s, max error %.2e\n",
+                DirectSummation::kernelName(), directCount, direct.lastStats.forceSeconds * 1000.0,
+                direct.lastStats.interactionsPerSecond, maxDirectError);
+
+    // Integrators: 1000 periods at 100 steps per period
+    BarnesHut leapfrog(0.0);
+    double leapfrogDrift = twoBodyDrift(leapfrog, 1000, 100);
+    double yoshidaDrift = twoBodyDrift(direct, 1000, 100);
+    std::printf("Energy drift after 1000 orbits (e = 0.5, 100 steps/orbit): leapfrog %.2e, Yoshida 4th order %.2e\n",
+                leapfrogDrift, yoshidaDrift);
+    return 0;
+}